@@ -0,0 +1,120 @@
+/*******************************************************************
+*   BoundedQueue.h
+*	Bounded lock-free multi-producer multi-consumer queue
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Fixed-capacity queue for handing work between pipeline stages,
+// e.g. reader -> converters -> writer. Any number of threads may push
+// and pop at once without locks: each cell carries a sequence number
+// saying whether it is ready to be written or read, and producers and
+// consumers each claim cells by advancing their own position with a
+// compare-and-swap (D. Vyukov's bounded MPMC queue).
+//
+// tryPush() and tryPop() never block. push() and pop() wait, yielding
+// the CPU, while the queue is full or empty, which is what bounds how
+// far a fast stage can run ahead of a slow one.
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// keeps the producer and consumer positions on separate cache lines
+#define CACHE_LINE_SIZE				(64)
+
+template <typename T>
+class BoundedQueue {
+public:
+	// capacity is rounded up to a power of 2
+	explicit BoundedQueue(const size_t capacity) : enqueuePos(0), dequeuePos(0) {
+		size_t size = 2;
+		while (size < capacity) size *= 2;
+		mask = size - 1;
+		cells.reset(new Cell[size]);
+		for (size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	BoundedQueue(const BoundedQueue&) = delete;
+	BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+	// Move value in, unless full. value is untouched if this fails.
+	bool tryPush(T& value) {
+		size_t pos = enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell& cell = cells[pos & mask];
+			const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+			const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+
+			// free cell: claim it...
+			if (diff == 0) {
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					cell.value = std::move(value);
+					cell.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			// ...full...
+			else if (diff < 0) {
+				return false;
+			}
+			// ...or another producer got there first
+			else {
+				pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Move the oldest value out into value, unless empty
+	bool tryPop(T& value) {
+		size_t pos = dequeuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell& cell = cells[pos & mask];
+			const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+			const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos + 1);
+
+			if (diff == 0) {
+				if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+					value = std::move(cell.value);
+					cell.sequence.store(pos + mask + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0) {
+				return false;
+			}
+			else {
+				pos = dequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void push(T& value) {
+		while (!tryPush(value)) std::this_thread::yield();
+	}
+
+	void pop(T& value) {
+		while (!tryPop(value)) std::this_thread::yield();
+	}
+
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	std::unique_ptr<Cell[]> cells;
+	size_t mask;
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos;
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos;
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*******************************************************************
+*   CivilSIMD.cpp
+*	Vectorized MET -> UTC field decomposition
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Bulk MET -> UTC decomposition for the TimeConverter batch calls.
+//
+// Each lane turns a MET into leap-corrected (nonleap) seconds since
+// epoch and then into year, month, day, hour, minute and second
+// using branch-free arithmetic in place of the scalar civilFromDays()
+// of the smart_tm constructor. The leap correction is a vectorized
+// compare of each lane against the leap seconds on either side of the
+// previous block.
+// Blocks with any lane outside that window (e.g. one that falls exactly
+// on a leap second, or crosses into the next) are handed to the scalar
+// smart_tm constructor instead, so results always match the scalar
+// TimeConverter::toUTC() bit for bit.
+//
+// Also home to the 16-byte 'YYYY?MM?DD?hh:mm' prefix reader
+// behind smart_tm::parseFixedWidth().
+
+#include "CivilSIMD.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+
+#define CIVIL_SIMD_AVX2
+#define CIVIL_SIMD_TARGET __attribute__((target("avx2")))
+#define PARSE_SIMD_TARGET __attribute__((target("ssse3")))
+
+static bool cpuHasAVX2() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+}
+
+static bool cpuHasSSSE3() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("ssse3");
+}
+
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+#include <immintrin.h>
+#include <intrin.h>
+
+#define CIVIL_SIMD_AVX2
+#define CIVIL_SIMD_TARGET
+#define PARSE_SIMD_TARGET
+
+static bool cpuHasSSSE3() {
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 9)) != 0;
+}
+
+static bool cpuHasAVX2() {
+	int info[4];
+	__cpuid(info, 1);
+	// the OS must also save the YMM registers on context switch
+	const bool osSavesYMM = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+	__cpuidex(info, 7, 0);
+	return osSavesYMM && (info[1] & (1 << 5));
+}
+
+#endif
+
+#ifdef CIVIL_SIMD_AVX2
+
+#define LANES						(4)
+
+// multiplying by 1/b rounded up by this factor makes floor(a * (1/b))
+// exactly floor(a / b) for every integral 0 <= a < 2^39
+#define RECIPROCAL_MARGIN			(1.0 + 1.0 / 1099511627776.0)
+#define MAX_EXACT_DIVIDEND			(549755813888.0)
+
+bool civilSIMDAvailable() {
+	static const bool available = cpuHasAVX2();
+	return available;
+}
+
+CIVIL_SIMD_TARGET static inline __m256d floorDiv(const __m256d a, const double b) {
+	return _mm256_floor_pd(_mm256_mul_pd(a, _mm256_set1_pd(RECIPROCAL_MARGIN / b)));
+}
+
+// a - b*c, exact for the small integers used here
+CIVIL_SIMD_TARGET static inline __m256d subMul(const __m256d a, const __m256d b, const double c) {
+	return _mm256_sub_pd(a, _mm256_mul_pd(b, _mm256_set1_pd(c)));
+}
+
+CIVIL_SIMD_TARGET static inline void storeField(long long* column, const __m256d field) {
+	if (column) _mm256_storeu_si256(reinterpret_cast<__m256i*>(column), _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(field)));
+}
+
+static inline void storeColumns(const smart_tm& time, const size_t i, const UTCColumns& columns) {
+	if (columns.yr) columns.yr[i] = time.yr;
+	if (columns.mon) columns.mon[i] = time.mon;
+	if (columns.day) columns.day[i] = time.day;
+	if (columns.hr) columns.hr[i] = time.hr;
+	if (columns.min) columns.min[i] = time.min;
+	if (columns.sec) columns.sec[i] = time.sec;
+	if (columns.fracSec) columns.fracSec[i] = time.fracSec;
+}
+
+// Epoch times strictly between which no leap second lies,
+// given the number of leap seconds before the last time converted.
+// Also keeps lanes in the range where floorDiv() is exact.
+static inline void leapWindow(const std::vector<size_t>& leapSeconds, const size_t leapHint, double& lo, double& hi) {
+	lo = (leapHint == 0) ? -1.0 : static_cast<double>(leapSeconds[leapHint - 1]);
+	hi = (leapHint == leapSeconds.size()) ? MAX_EXACT_DIVIDEND : std::min(static_cast<double>(leapSeconds[leapHint]), MAX_EXACT_DIVIDEND);
+}
+
+CIVIL_SIMD_TARGET static void civilFromMETsAVX2(const double* METs, const size_t n, const size_t startEpoch, const double startFracSec, const UTCColumns& timesOut, const TimeContext& context) {
+	const std::vector<size_t>& leapSeconds = context.leapSecondEpochs();
+	size_t leapHint = 0;
+	double lo, hi;
+	leapWindow(leapSeconds, leapHint, lo, hi);
+
+	// day number of epoch, counted from the start of the first March-based era
+	const double epochEraDays = static_cast<double>(daysFromCivil(context.epochYear(), START_MON, START_DAY) + ERA_START_TO_DEFAULT_EPOCH);
+
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d one = _mm256_set1_pd(1.0);
+	const __m256d startEpochV = _mm256_set1_pd(static_cast<double>(startEpoch));
+	const __m256d startFracSecV = _mm256_set1_pd(startFracSec);
+	const __m256d epochEraDaysV = _mm256_set1_pd(epochEraDays);
+
+	size_t i = 0;
+	for (; i + LANES <= n; i += LANES) {
+		const __m256d MET = _mm256_loadu_pd(METs + i);
+
+		// same operations, in the same order, as the scalar path:
+		// whole seconds by truncation, fractional by floor...
+		const __m256d wholeMET = _mm256_round_pd(MET, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+		__m256d fracSec = _mm256_add_pd(startFracSecV, _mm256_sub_pd(MET, _mm256_floor_pd(MET)));
+
+		// ...then fractional seconds out of [0, 1) carried into whole seconds
+		const __m256d fracInLimits = _mm256_and_pd(_mm256_cmp_pd(fracSec, zero, _CMP_GE_OQ), _mm256_cmp_pd(fracSec, one, _CMP_LT_OQ));
+		const __m256d carry = _mm256_andnot_pd(fracInLimits, _mm256_floor_pd(fracSec));
+		fracSec = _mm256_sub_pd(fracSec, carry);
+		const __m256d sinceEpoch = _mm256_add_pd(_mm256_add_pd(startEpochV, wholeMET), carry);
+
+		// all lanes strictly between the same two leap seconds?
+		const __m256d inWindow = _mm256_and_pd(_mm256_cmp_pd(sinceEpoch, _mm256_set1_pd(lo), _CMP_GT_OQ), _mm256_cmp_pd(sinceEpoch, _mm256_set1_pd(hi), _CMP_LT_OQ));
+		if (_mm256_movemask_pd(inWindow) != (1 << LANES) - 1) {
+			// if not, scalar fixup, which also moves the window along
+			for (size_t j = i; j < i + LANES; ++j) {
+				storeColumns(smart_tm(startEpoch + static_cast<size_t>(METs[j]), startFracSec + (METs[j] - floor(METs[j])), leapHint, context), j, timesOut);
+			}
+			leapWindow(leapSeconds, leapHint, lo, hi);
+			continue;
+		}
+
+		// nonleap seconds split into days and seconds of day...
+		const __m256d nonleap = _mm256_sub_pd(sinceEpoch, _mm256_set1_pd(static_cast<double>(leapHint)));
+		const __m256d dayCount = floorDiv(nonleap, SECONDS_PER_DAY);
+		const __m256d secOfDay = subMul(nonleap, dayCount, SECONDS_PER_DAY);
+
+		// ...days into 400-year era, year of era and day of (March-based) year,
+		// as in civilFromDays()...
+		const __m256d z = _mm256_add_pd(dayCount, epochEraDaysV);
+		const __m256d era = floorDiv(z, DAYS_PER_400_YEARS);
+		const __m256d dayOfEra = subMul(z, era, DAYS_PER_400_YEARS);
+		const __m256d yrOfEra = floorDiv(_mm256_add_pd(_mm256_sub_pd(dayOfEra, floorDiv(dayOfEra, DAYS_PER_4_YEARS)), _mm256_sub_pd(floorDiv(dayOfEra, DAYS_PER_100_YEARS), floorDiv(dayOfEra, DAYS_PER_400_YEARS - 1))), TYPICAL_DAYS_PER_YEAR);
+		const __m256d dayOfYr = _mm256_sub_pd(dayOfEra, _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(yrOfEra, _mm256_set1_pd(TYPICAL_DAYS_PER_YEAR)), floorDiv(yrOfEra, 4)), floorDiv(yrOfEra, 100)));
+
+		// ...and finally month and day, without branches
+		const __m256d shiftedMon = floorDiv(_mm256_add_pd(_mm256_mul_pd(dayOfYr, _mm256_set1_pd(5.0)), _mm256_set1_pd(2.0)), 153);
+		const __m256d day = _mm256_add_pd(_mm256_sub_pd(dayOfYr, floorDiv(_mm256_add_pd(_mm256_mul_pd(shiftedMon, _mm256_set1_pd(153.0)), _mm256_set1_pd(2.0)), 5)), _mm256_set1_pd(START_DAY));
+		const __m256d mon = _mm256_add_pd(shiftedMon, _mm256_blendv_pd(_mm256_set1_pd(-9.0), _mm256_set1_pd(3.0), _mm256_cmp_pd(shiftedMon, _mm256_set1_pd(10.0), _CMP_LT_OQ)));
+		const __m256d yr = _mm256_add_pd(_mm256_add_pd(yrOfEra, _mm256_mul_pd(era, _mm256_set1_pd(400.0))), _mm256_and_pd(_mm256_cmp_pd(mon, _mm256_set1_pd(2.0), _CMP_LE_OQ), one));
+
+		const __m256d hr = floorDiv(secOfDay, SECONDS_PER_HOUR);
+		const __m256d secOfHr = subMul(secOfDay, hr, SECONDS_PER_HOUR);
+		const __m256d min = floorDiv(secOfHr, TYPICAL_SECONDS_PER_MINUTE);
+		const __m256d sec = subMul(secOfHr, min, TYPICAL_SECONDS_PER_MINUTE);
+
+		storeField(timesOut.yr ? timesOut.yr + i : nullptr, yr);
+		storeField(timesOut.mon ? timesOut.mon + i : nullptr, mon);
+		storeField(timesOut.day ? timesOut.day + i : nullptr, day);
+		storeField(timesOut.hr ? timesOut.hr + i : nullptr, _mm256_add_pd(hr, _mm256_set1_pd(START_HR)));
+		storeField(timesOut.min ? timesOut.min + i : nullptr, _mm256_add_pd(min, _mm256_set1_pd(START_MIN)));
+		storeField(timesOut.sec ? timesOut.sec + i : nullptr, _mm256_add_pd(sec, _mm256_set1_pd(START_SEC)));
+		if (timesOut.fracSec) _mm256_storeu_pd(timesOut.fracSec + i, fracSec);
+	}
+
+	// remainder
+	for (; i < n; ++i) {
+		storeColumns(smart_tm(startEpoch + static_cast<size_t>(METs[i]), startFracSec + (METs[i] - floor(METs[i])), leapHint, context), i, timesOut);
+	}
+}
+
+bool civilFromMETsSIMD(const double* METs, const size_t n, const size_t startEpoch, const double startFracSec, const UTCColumns& timesOut, const TimeContext& context) {
+	if (!civilSIMDAvailable()) return false;
+
+	civilFromMETsAVX2(METs, n, startEpoch, startFracSec, timesOut, context);
+	return true;
+}
+
+// byte positions of the digits in 'YYYY?MM?DD?hh:mm'
+#define PREFIX_DIGIT_MASK			(0xDB6F)
+
+PARSE_SIMD_TARGET static bool datePrefixSSSE3(const char* text, long long* fields) {
+	const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), _mm_set1_epi8('0'));
+
+	// every digit position really a digit? (non-digits wrap past 9)
+	const __m128i isDigit = _mm_cmpeq_epi8(_mm_subs_epu8(digits, _mm_set1_epi8(9)), _mm_setzero_si128());
+	if ((_mm_movemask_epi8(isDigit) & PREFIX_DIGIT_MASK) != PREFIX_DIGIT_MASK) return false;
+
+	// gather the digits into adjacent pairs and combine each as 10 * a + b
+	const __m128i pairs = _mm_shuffle_epi8(digits, _mm_setr_epi8(0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1));
+	const __m128i values = _mm_maddubs_epi16(pairs, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 0, 0, 0, 0));
+
+	fields[0] = _mm_extract_epi16(values, 0) * 100 + _mm_extract_epi16(values, 1);
+	fields[1] = _mm_extract_epi16(values, 2);
+	fields[2] = _mm_extract_epi16(values, 3);
+	fields[3] = _mm_extract_epi16(values, 4);
+	fields[4] = _mm_extract_epi16(values, 5);
+	return true;
+}
+
+const char* parseDatePrefixSIMD(const char* text, long long* fields) {
+	static const bool available = cpuHasSSSE3();
+	if (!available) return nullptr;
+
+	// separators as smart_tm::parse() would accept them
+	const char dateSeparator = text[4];
+	if (dateSeparator != '/' && dateSeparator != '-' && dateSeparator != ':') return nullptr;
+	if (text[7] != dateSeparator || text[13] != ':') return nullptr;
+	if (text[10] != 'T' && text[10] != ' ' && text[10] != dateSeparator) return nullptr;
+
+	return datePrefixSSSE3(text, fields) ? text + SIMD_DATE_PREFIX_LENGTH : nullptr;
+}
+
+#else
+
+bool civilSIMDAvailable() {
+	return false;
+}
+
+bool civilFromMETsSIMD(const double*, const size_t, const size_t, const double, const UTCColumns&, const TimeContext&) {
+	return false;
+}
+
+const char* parseDatePrefixSIMD(const char*, long long*) {
+	return nullptr;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*******************************************************************
+*   CivilSIMD.h
+*	Vectorized MET -> UTC field decomposition
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Bulk MET -> UTC decomposition for the TimeConverter batch calls.
+//
+// Each lane turns a MET into leap-corrected (nonleap) seconds since
+// epoch and then into year, month, day, hour, minute and second
+// using branch-free arithmetic in place of the scalar civilFromDays()
+// of the smart_tm constructor. The leap correction is a vectorized
+// compare of each lane against the leap seconds on either side of the
+// previous block.
+// Blocks with any lane outside that window (e.g. one that falls exactly
+// on a leap second, or crosses into the next) are handed to the scalar
+// smart_tm constructor instead, so results always match the scalar
+// TimeConverter::toUTC() bit for bit.
+//
+// The CPU is checked at runtime. On CPUs or compilers without
+// AVX2 support, the calls below return false without doing anything
+// and the caller should fall back to the scalar path.
+//
+// Also home to the 16-byte 'YYYY?MM?DD?hh:mm' prefix reader
+// behind smart_tm::parseFixedWidth(), which needs SSSE3.
+
+#ifndef CIVIL_SIMD_H
+#define CIVIL_SIMD_H
+
+#include "smart_tm.h"
+#include "UTC_MET.h"
+
+// Does this CPU (and build) support the vectorized path?
+bool civilSIMDAvailable();
+
+// Equivalent to TimeConverter::toUTC(METs, n, timesOut) for a mission
+// starting startEpoch + startFracSec seconds after epoch of context.
+// Returns false, without writing anything, if not civilSIMDAvailable().
+bool civilFromMETsSIMD(const double* METs, const size_t n, const size_t startEpoch, const double startFracSec, const UTCColumns& timesOut, const TimeContext& context);
+
+// Bytes read by parseDatePrefixSIMD()
+#define SIMD_DATE_PREFIX_LENGTH		(16)
+
+// Reads the year, month, day, hour and minute out of the first
+// SIMD_DATE_PREFIX_LENGTH bytes at text, all of which must be readable,
+// if they are laid out as 'YYYY?MM?DD?hh:mm' with separators as
+// smart_tm::parse() accepts them. Returns the first byte past the
+// prefix, or nullptr without checking ranges if not laid out
+// that way, or not supported on this CPU.
+const char* parseDatePrefixSIMD(const char* text, long long* fields);
+
+#endif
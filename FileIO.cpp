@@ -19,6 +19,20 @@
 
 #include "FileIO.h"
 
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 std::istream& safeGetline(std::istream& is, std::string& line) {
 	line.clear();
 
@@ -50,13 +64,17 @@ std::istream& safeGetline(std::istream& is, std::string& line) {
 }
 
 bool getNextLine(std::ifstream& is, std::string& line) {
+	return getNextLine(is, line, std::string());
+}
+
+bool getNextLine(std::ifstream& is, std::string& line, const std::string& keepPrefix) {
 	bool more = true;
 
 	while (more) {
 		safeGetline(is, line);
 
 		if (!is.eof()) {
-			if (line.empty() || line[0] == '#') {
+			if (line.empty() || (line[0] == '#' && (keepPrefix.empty() || line.compare(0, keepPrefix.size(), keepPrefix) != 0))) {
 				continue;
 			}
 			more = false;
@@ -67,4 +85,219 @@ bool getNextLine(std::ifstream& is, std::string& line) {
 		}
 	}
 	return true;
-}
\ No newline at end of file
+}
+
+bool nextLine(std::string_view& text, std::string_view& line) {
+	while (!text.empty()) {
+		const char* begin = text.data();
+		const char* end = begin + text.size();
+
+		// memchr() is vectorized by the C library, so scan for the newline
+		// with it, then for a '\r' within the line the same way
+		const char* newline = static_cast<const char*>(memchr(begin, '\n', text.size()));
+		const char* lineEnd = newline ? newline : end;
+		const char* next = newline ? newline + 1 : end;
+		const char* cr = static_cast<const char*>(memchr(begin, '\r', lineEnd - begin));
+		if (cr) {
+			lineEnd = cr;
+			next = (cr + 1 < end && cr[1] == '\n') ? cr + 2 : cr + 1;
+		}
+
+		text.remove_prefix(next - begin);
+
+		if (lineEnd == begin || *begin == '#') {
+			continue;
+		}
+
+		line = std::string_view(begin, lineEnd - begin);
+		return true;
+	}
+	return false;
+}
+
+MappedFile::~MappedFile() {
+	if (!mapData) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mapData);
+	CloseHandle(static_cast<HANDLE>(mapHandle));
+#else
+	munmap(const_cast<char*>(mapData), mapSize);
+#endif
+}
+
+bool MappedFile::open(const std::string& path, const bool sequential) {
+#ifdef _WIN32
+	HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+	LARGE_INTEGER size;
+	if (f != INVALID_HANDLE_VALUE && GetFileType(f) == FILE_TYPE_DISK && GetFileSizeEx(f, &size)) {
+		mapSize = static_cast<size_t>(size.QuadPart);
+		if (mapSize == 0) {
+			mapped = true;
+		}
+		else {
+			HANDLE mapping = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping) {
+				mapData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				if (mapData) {
+					mapped = true;
+					mapHandle = mapping;
+				}
+				else {
+					CloseHandle(mapping);
+				}
+			}
+		}
+	}
+	if (f != INVALID_HANDLE_VALUE) CloseHandle(f);
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	struct stat info;
+	if (fd >= 0 && fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+		mapSize = static_cast<size_t>(info.st_size);
+		if (mapSize == 0) {
+			mapped = true;
+		}
+		else {
+			void* data = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED) {
+				madvise(data, mapSize, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+				mapData = static_cast<const char*>(data);
+				mapped = true;
+			}
+		}
+	}
+	if (fd >= 0) close(fd);
+#endif
+
+	if (!mapped) mapSize = 0;
+	return mapped;
+}
+
+LineReader::LineReader(const std::string& path, const size_t chunkSize /* =DEFAULT_CHUNK_SIZE */)
+	: mapped(false), mapData(nullptr), mapSize(0), mapPos(0), stream(nullptr),
+	bufBegin(0), bufEnd(0), streamDone(false), chunkSize(std::max(chunkSize, static_cast<size_t>(1))), nextChunkIndex(0) {
+
+	if (map.open(path, true)) {
+		mapped = true;
+		mapData = map.data();
+		mapSize = map.size();
+	}
+
+	// fall back to reading the file in blocks
+	else {
+		file.open(path, std::ios::in | std::ios::binary);
+		if (file) stream = &file;
+	}
+}
+
+LineReader::LineReader(std::istream& is, const size_t chunkSize /* =DEFAULT_CHUNK_SIZE */)
+	: mapped(false), mapData(nullptr), mapSize(0), mapPos(0), stream(&is),
+	bufBegin(0), bufEnd(0), streamDone(false), chunkSize(std::max(chunkSize, static_cast<size_t>(1))), nextChunkIndex(0) {}
+
+bool LineReader::refill() {
+	if (streamDone || !stream) return false;
+
+	// keep what has not been used yet, growing the buffer when
+	// that is all of it, i.e. a line longer than the buffer
+	const size_t unused = bufEnd - bufBegin;
+	if (bufBegin) memmove(buffer.data(), buffer.data() + bufBegin, unused);
+	bufBegin = 0;
+	bufEnd = unused;
+	if (buffer.size() - unused < STREAM_BUFFER_SIZE / 2) buffer.resize(std::max(buffer.size() * 2, static_cast<size_t>(STREAM_BUFFER_SIZE)));
+
+	stream->read(buffer.data() + bufEnd, buffer.size() - bufEnd);
+	const size_t count = static_cast<size_t>(stream->gcount());
+	bufEnd += count;
+	if (!*stream) streamDone = true;
+	return count != 0;
+}
+
+bool LineReader::getNextLine(std::string_view& line) {
+	if (mapped) {
+		std::string_view text(mapData + mapPos, mapSize - mapPos);
+		const bool found = nextLine(text, line);
+		mapPos = mapSize - text.size();
+		return found;
+	}
+
+	for (;;) {
+		// a line is complete once its newline has been read,
+		// or the stream has ended
+		const char* begin = buffer.data() + bufBegin;
+		const char* newline = (bufEnd > bufBegin) ? static_cast<const char*>(memchr(begin, '\n', bufEnd - bufBegin)) : nullptr;
+		if (!newline && refill()) continue;
+
+		std::string_view text(begin, newline ? newline + 1 - begin : bufEnd - bufBegin);
+		const size_t available = text.size();
+		const bool found = nextLine(text, line);
+		bufBegin += available - text.size();
+		if (found) return true;
+		if (!newline) return false;
+	}
+}
+
+size_t LineReader::lineStartAtOrAfter(const size_t offset) const {
+	if (offset == 0) return 0;
+	if (offset >= mapSize) return mapSize;
+
+	// the line starting at offset, if the one before it ends right there
+	const char* newline = static_cast<const char*>(memchr(mapData + offset - 1, '\n', mapSize - offset + 1));
+	return newline ? newline + 1 - mapData : mapSize;
+}
+
+bool LineReader::getNextChunk(LineChunk& chunk) {
+	if (mapped) {
+		// each thread claims the next index, then finds its own
+		// line boundaries, so no two threads ever touch the same state
+		const size_t index = nextChunkIndex.fetch_add(1, std::memory_order_relaxed);
+		if (index >= (mapSize + chunkSize - 1) / chunkSize) return false;
+
+		const size_t begin = lineStartAtOrAfter(index * chunkSize);
+		const size_t end = lineStartAtOrAfter((index + 1) * chunkSize);
+		chunk.text = std::string_view(mapData + begin, end - begin);
+		chunk.index = index;
+		return true;
+	}
+
+	std::lock_guard<std::mutex> guard(streamLock);
+
+	// chunkSize bytes, or all that's left...
+	while (bufEnd - bufBegin < chunkSize && refill()) {}
+	if (bufEnd == bufBegin) return false;
+
+	// ...and up to the end of the line
+	size_t searchFrom = std::min(chunkSize, bufEnd - bufBegin) - 1;
+	size_t length;
+	for (;;) {
+		const char* newline = static_cast<const char*>(memchr(buffer.data() + bufBegin + searchFrom, '\n', bufEnd - bufBegin - searchFrom));
+		if (newline) {
+			length = newline + 1 - (buffer.data() + bufBegin);
+			break;
+		}
+		searchFrom = bufEnd - bufBegin;
+		if (!refill()) {
+			length = bufEnd - bufBegin;
+			break;
+		}
+	}
+
+	chunk.storage.assign(buffer.data() + bufBegin, buffer.data() + bufBegin + length);
+	chunk.text = std::string_view(chunk.storage.data(), length);
+	chunk.index = nextChunkIndex.fetch_add(1, std::memory_order_relaxed);
+	bufBegin += length;
+	return true;
+}
+
+std::vector<std::string_view> LineReader::split(const size_t parts) const {
+	std::vector<std::string_view> ret;
+	if (!mapped || parts == 0) return ret;
+
+	const size_t partSize = (mapSize + parts - 1) / parts;
+	for (size_t i = 0; i < parts; ++i) {
+		const size_t begin = lineStartAtOrAfter(i * partSize);
+		const size_t end = lineStartAtOrAfter((i + 1) * partSize);
+		ret.push_back(std::string_view(mapData + begin, end - begin));
+	}
+	return ret;
+}
@@ -16,15 +16,169 @@
 // the system getline() call. It is also able to retrive data from
 // the last line of a file even if the file does not have a trailing
 // newline.
+//
+// For bulk input (e.g. multi-GB dumps of METs), LineReader yields the
+// same lines as getNextLine() as string_views into a memory-mapped file,
+// without copying or a per-character loop. Where mapping is not possible
+// (pipes, stdin, special files) it falls back to reading large blocks.
+// It can also hand out whole-line chunks of the file to many threads
+// at once, numbered in file order so results can be put back in order.
+//
+// Example, single-threaded:
+/*
+
+LineReader reader("METs.txt");
+std::string_view line;
+while (reader.getNextLine(line)) {
+	...
+}
+
+*/
+//
+// Example, from any number of threads sharing one reader:
+/*
+
+LineChunk chunk;
+std::string_view line;
+while (reader.getNextChunk(chunk)) {
+	// chunk.index is the chunk's position in the file
+	while (nextLine(chunk.text, line)) {
+		...
+	}
+}
+
+*/
 
 #ifndef FILEIO_H
 #define FILEIO_H
 
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <istream>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #define DO_NOT_SKIP_WHITESPACE (true)
 
+// bytes read at a time when LineReader cannot map its file
+#define STREAM_BUFFER_SIZE		(1 << 20)
+
+// default nominal size of LineReader::getNextChunk() chunks
+#define DEFAULT_CHUNK_SIZE		(1 << 22)
+
 bool getNextLine(std::ifstream& is, std::string& line);
 
+// As above, but comment lines starting with keepPrefix
+// (e.g. the '#@' expiry line of leap-seconds.list) are returned too
+bool getNextLine(std::ifstream& is, std::string& line, const std::string& keepPrefix);
+
+// Take the next line of text, as getNextLine() would from a file
+// holding just that text, and advance text past it. Lines end in
+// '\n', '\r\n' or '\r', and empty lines and '#' comments are skipped.
+// The line is a view into text, without its line ending.
+// Returns false, leaving text empty, if there are no more lines.
+bool nextLine(std::string_view& text, std::string_view& line);
+
+// A run of whole lines handed out by LineReader::getNextChunk()
+struct LineChunk {
+	// the lines, to be split with nextLine()
+	std::string_view text;
+
+	// position of this chunk in the file, counting from 0
+	size_t index;
+
+	// holds the text if the file is not mapped; otherwise unused
+	std::vector<char> storage;
+};
+
+// Read-only memory mapping of a whole regular file
+class MappedFile {
+public:
+	MappedFile() : mapped(false), mapData(nullptr), mapSize(0), mapHandle(nullptr) {}
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Map the file at path, hinting sequential or random access to the OS.
+	// False if it is not a regular file or cannot be mapped.
+	// An empty file maps, with no data.
+	bool open(const std::string& path, const bool sequential);
+
+	bool isMapped() const { return mapped; }
+	const char* data() const { return mapData; }
+	size_t size() const { return mapSize; }
+
+private:
+	bool mapped;
+	const char* mapData;
+	size_t mapSize;
+	void* mapHandle;
+};
+
+class LineReader {
+public:
+	// Open and, if possible, memory-map the file at path
+	explicit LineReader(const std::string& path, const size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+	// Read from an already open stream, e.g. std::cin, never mapped
+	explicit LineReader(std::istream& is, const size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+	LineReader(const LineReader&) = delete;
+	LineReader& operator=(const LineReader&) = delete;
+
+	// Was the file opened?
+	bool isOpen() const { return mapped || stream; }
+
+	// Is the whole file in memory, so that split() works?
+	bool isMapped() const { return mapped; }
+
+	// Get the next line, as getNextLine() would. If the file is mapped, the
+	// line stays valid for the life of the reader; otherwise only until
+	// the next call. Not to be called from several threads at once.
+	bool getNextLine(std::string_view& line);
+
+	// Get the next chunk of about chunkSize bytes of whole lines, together
+	// with its index. Safe to call from any number of threads at once;
+	// lock-free if the file is mapped. A line longer than chunkSize may
+	// make a chunk empty, though it still gets its index.
+	// Files with lone '\r' line endings are not split into chunks.
+	// Do not mix with getNextLine() on the same reader.
+	bool getNextChunk(LineChunk& chunk);
+
+	// Split the whole file into 'parts' runs of whole lines of about equal
+	// size, for one thread each. Empty if the file is not mapped.
+	std::vector<std::string_view> split(const size_t parts) const;
+
+private:
+	// Offset of the first line starting at or after offset in the mapping
+	size_t lineStartAtOrAfter(const size_t offset) const;
+
+	// Read more of the stream into buffer, first moving
+	// the unused part to the front. False at end of stream.
+	bool refill();
+
+	// memory-mapped file...
+	MappedFile map;
+	bool mapped;
+	const char* mapData;
+	size_t mapSize;
+	size_t mapPos;
+
+	// ...or stream with its read buffer
+	std::ifstream file;
+	std::istream* stream;
+	std::vector<char> buffer;
+	size_t bufBegin;
+	size_t bufEnd;
+	bool streamDone;
+
+	size_t chunkSize;
+	std::atomic<size_t> nextChunkIndex;
+	std::mutex streamLock;
+};
+
 #endif
\ No newline at end of file
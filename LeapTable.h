@@ -0,0 +1,31 @@
+/*******************************************************************
+*   LeapTable.h
+*	Built-in leap second table
+*   Smart Time System
+*
+*	GENERATED by LeapTableGen from leap-seconds.list. Do not edit;
+*	rerun LeapTableGen on a newer leap file instead.
+*******************************************************************/
+
+// Leap file entries as listed: seconds since 1900 ignoring leap seconds,
+// ascending, and the file's expiry on the same scale
+
+#ifndef LEAP_TABLE_H
+#define LEAP_TABLE_H
+
+#include <cstddef>
+
+#define EMBEDDED_LEAP_COUNT			(27)
+#define EMBEDDED_LEAP_EXPIRY		(3660249600ULL)
+
+static constexpr size_t embeddedLeapTimes[EMBEDDED_LEAP_COUNT] = {
+	2272060800ULL, 2287785600ULL, 2303683200ULL, 2335219200ULL,
+	2366755200ULL, 2398291200ULL, 2429913600ULL, 2461449600ULL,
+	2492985600ULL, 2524521600ULL, 2571782400ULL, 2603318400ULL,
+	2634854400ULL, 2698012800ULL, 2776982400ULL, 2840140800ULL,
+	2871676800ULL, 2918937600ULL, 2950473600ULL, 2982009600ULL,
+	3029443200ULL, 3076704000ULL, 3124137600ULL, 3345062400ULL,
+	3439756800ULL, 3550089600ULL, 3644697600ULL
+};
+
+#endif
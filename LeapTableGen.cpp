@@ -0,0 +1,109 @@
+/*******************************************************************
+*   LeapTableGen.cpp
+*	Build-time leap table generator
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Standalone tool which turns an official IETF/IERS leap second file,
+// typically named 'leap-seconds.list', into LeapTable.h, the leap table
+// built into the program for smart_tm::init(epochYr) and
+// TimeContext::create(epochYr). Programs using it start with no file I/O.
+//
+// Rebuild and rerun whenever a new leap-seconds.list is published,
+// as part of the build:
+/*
+
+g++ -O2 -o LeapTableGen LeapTableGen.cpp FileIO.cpp
+./LeapTableGen leap-seconds.list LeapTable.h
+
+*/
+//
+// The leap times are written exactly as listed (seconds since 1900,
+// ignoring leap seconds), and TimeContext::create() processes them
+// exactly as it would the file itself, so the embedded and file-based
+// contexts are identical.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FileIO.h"
+
+#define BASE_10_PLEASE				(10)
+#define VALUES_PER_LINE				(4)
+
+int main(int argc, char* argv[]) {
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0] << " <leap-seconds.list> <LeapTable.h>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream fLeap(argv[1]);
+	if (!fLeap) {
+		std::cerr << "ERROR: Failed to open " << argv[1] << '.' << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// same parse as TimeContext::create()
+	std::vector<unsigned long long> leapTimes;
+	unsigned long long expiryNTP = 0;
+	std::string strLine;
+	while (getNextLine(fLeap, strLine, "#@")) {
+		if (strLine[0] == '#') {
+			expiryNTP = strtoull(strLine.c_str() + 2, nullptr, BASE_10_PLEASE);
+		}
+		else {
+			leapTimes.push_back(strtoull(strLine.substr(0, strLine.find_first_not_of("0123456789")).c_str(), nullptr, BASE_10_PLEASE));
+		}
+	}
+	fLeap.close();
+
+	if (leapTimes.empty()) {
+		std::cerr << "ERROR: No leap seconds in " << argv[1] << '.' << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream out(argv[2]);
+	if (!out) {
+		std::cerr << "ERROR: Failed to open " << argv[2] << '.' << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	out << "/*******************************************************************\n"
+		<< "*   LeapTable.h\n"
+		<< "*	Built-in leap second table\n"
+		<< "*   Smart Time System\n"
+		<< "*\n"
+		<< "*	GENERATED by LeapTableGen from leap-seconds.list. Do not edit;\n"
+		<< "*	rerun LeapTableGen on a newer leap file instead.\n"
+		<< "*******************************************************************/\n"
+		<< '\n'
+		<< "// Leap file entries as listed: seconds since 1900 ignoring leap seconds,\n"
+		<< "// ascending, and the file's expiry on the same scale\n"
+		<< '\n'
+		<< "#ifndef LEAP_TABLE_H\n"
+		<< "#define LEAP_TABLE_H\n"
+		<< '\n'
+		<< "#include <cstddef>\n"
+		<< '\n'
+		<< "#define EMBEDDED_LEAP_COUNT\t\t\t(" << leapTimes.size() << ")\n"
+		<< "#define EMBEDDED_LEAP_EXPIRY\t\t(" << expiryNTP << "ULL)\n"
+		<< '\n'
+		<< "static constexpr size_t embeddedLeapTimes[EMBEDDED_LEAP_COUNT] = {";
+
+	for (size_t i = 0; i < leapTimes.size(); ++i) {
+		out << ((i % VALUES_PER_LINE == 0) ? "\n\t" : " ") << leapTimes[i] << "ULL" << ((i + 1 < leapTimes.size()) ? "," : "");
+	}
+
+	out << "\n};\n"
+		<< '\n'
+		<< "#endif\n";
+
+	return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,353 @@
+/*******************************************************************
+*   MetConvert.cpp
+*	Command-line bulk MET <-> UTC converter
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Converts a text file of METs to UTC times, or of UTC times to METs,
+// one per line, in line order, using every core.
+//
+// The work is a three-stage pipeline connected by bounded lock-free
+// queues (see BoundedQueue.h), so reading, converting and writing all
+// overlap:
+//	reader		hands out numbered chunks of whole lines (LineReader)
+//	converters	parse, convert with the batch TimeConverter calls and
+//				format into the chunk's own output buffer
+//	writer		writes the chunks back out in their original order
+// A fixed pool of chunks circulates from reader to writer and back,
+// which bounds memory and keeps a stalled converter from letting
+// the others run arbitrarily far ahead.
+//
+// Lines are read with the same rules as getNextLine(), so empty lines
+// and '#' comments are skipped. A line that cannot be converted is
+// written as a '# invalid: ' comment in its place, so output stays
+// aligned with input, and the exit status is then 1. For to-utc, this
+// includes METs that are not finite, are negative or are 2^53 or more.
+//
+// Build, for example:
+/*
+
+g++ -O2 -std=c++17 -pthread -o MetConvert MetConvert.cpp smart_tm.cpp TimeContext.cpp UTC_MET.cpp CivilSIMD.cpp TimeFormat.cpp FileIO.cpp
+
+*/
+//
+// Example use:
+/*
+
+MetConvert to-utc 2001-01-01T00:00:00 -i METs.txt -o UTC.txt -f "%Y-%m-%dT%H:%M:%S.%3fZ"
+MetConvert to-met 2001-01-01T00:00:00 -l leap-seconds.list < UTC.txt > METs.txt
+
+*/
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BoundedQueue.h"
+#include "FileIO.h"
+#include "TimeFormat.h"
+#include "UTC_MET.h"
+#include "smart_tm.h"
+
+// chunks in circulation per converter thread
+#define CHUNKS_PER_THREAD			(4)
+
+#define OUTPUT_BUFFER_SIZE			(1 << 22)
+
+// largest MET whose whole seconds a double holds exactly
+#define MAX_MET						(9007199254740992.0)
+
+#define EXIT_INVALID_LINES			(1)
+#define EXIT_USAGE					(2)
+
+struct Options {
+	bool toUTC;
+	std::string launch;
+	long long epochYr;
+	std::string leapFile;
+	std::string input;
+	std::string output;
+	std::string pattern;
+	size_t threads;
+	size_t chunkSize;
+};
+
+struct Job {
+	LineChunk chunk;
+	std::string out;
+	size_t outLen;
+	size_t invalidLines;
+	bool last;
+
+	Job() : outLen(0), invalidLines(0), last(false) {}
+};
+
+typedef std::unique_ptr<Job> JobPtr;
+
+static void usage(const char* name) {
+	std::cerr << "Usage: " << name << " to-utc|to-met LAUNCH [options]" << std::endl
+		<< "  LAUNCH       mission start (MET 0) in UTC, e.g. 2001-01-01T00:00:00" << std::endl
+		<< "  -i FILE      input, one MET or UTC time per line (default stdin)" << std::endl
+		<< "  -o FILE      output (default stdout)" << std::endl
+		<< "  -l FILE      leap second file (default: built-in table)" << std::endl
+		<< "  -e YEAR      epoch year (default " << DEFAULT_EPOCH_YEAR << ")" << std::endl
+		<< "  -f PATTERN   UTC output pattern, as for TimeFormat (default as toString())" << std::endl
+		<< "  -t N         converter threads (default: all cores)" << std::endl
+		<< "  -c BYTES     input chunk size (default " << DEFAULT_CHUNK_SIZE << ")" << std::endl;
+}
+
+static bool parseOptions(const int argc, char* argv[], Options& opts) {
+	if (argc < 3) return false;
+
+	const std::string direction = argv[1];
+	if (direction != "to-utc" && direction != "to-met") return false;
+	opts.toUTC = (direction == "to-utc");
+	opts.launch = argv[2];
+	opts.epochYr = DEFAULT_EPOCH_YEAR;
+	opts.threads = std::max(std::thread::hardware_concurrency(), 1U);
+	opts.chunkSize = DEFAULT_CHUNK_SIZE;
+
+	for (int i = 3; i < argc; i += 2) {
+		const std::string flag = argv[i];
+		if (i + 1 >= argc || flag.size() != 2 || flag[0] != '-') return false;
+
+		const char* value = argv[i + 1];
+		switch (flag[1]) {
+		case 'i': opts.input = value; break;
+		case 'o': opts.output = value; break;
+		case 'l': opts.leapFile = value; break;
+		case 'e': opts.epochYr = strtoll(value, nullptr, BASE_10_PLEASE); break;
+		case 'f': opts.pattern = value; break;
+		case 't': opts.threads = std::max(strtoull(value, nullptr, BASE_10_PLEASE), 1ULL); break;
+		case 'c': opts.chunkSize = std::max(strtoull(value, nullptr, BASE_10_PLEASE), 1ULL); break;
+		default: return false;
+		}
+	}
+	return true;
+}
+
+static std::string_view trim(std::string_view line) {
+	while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+	while (!line.empty() && (line.back() == ' ' || line.back() == '\t')) line.remove_suffix(1);
+	return line;
+}
+
+// room for at least len more characters of output
+static char* reserve(Job& job, const size_t len) {
+	if (job.out.size() - job.outLen < len) job.out.resize(std::max(job.out.size() * 2, job.outLen + len));
+	return &job.out[job.outLen];
+}
+
+static void writeInvalid(Job& job, const std::string_view line) {
+	static const std::string_view prefix = "# invalid: ";
+	char* out = reserve(job, prefix.size() + line.size() + 1);
+	memcpy(out, prefix.data(), prefix.size());
+	memcpy(out + prefix.size(), line.data(), line.size());
+	out[prefix.size() + line.size()] = '\n';
+	job.outLen += prefix.size() + line.size() + 1;
+	++job.invalidLines;
+}
+
+// Per-thread scratch space, kept across chunks to avoid reallocating
+struct Scratch {
+	std::vector<std::string_view> lines;
+	std::vector<bool> valid;
+	std::vector<double> METs;
+	std::vector<smart_tm> times;
+};
+
+static void convertToUTC(Job& job, Scratch& scratch, const TimeConverter& conv, const TimeFormat* format) {
+	// parse...
+	std::string_view text = job.chunk.text, line;
+	while (nextLine(text, line)) {
+		line = trim(line);
+		double MET;
+		const std::from_chars_result result = std::from_chars(line.data(), line.data() + line.size(), MET);
+		// NaN fails both comparisons
+		const bool valid = result.ec == std::errc() && result.ptr == line.data() + line.size() && MET >= 0.0 && MET < MAX_MET;
+		scratch.lines.push_back(line);
+		scratch.valid.push_back(valid);
+		if (valid) scratch.METs.push_back(MET);
+	}
+
+	// ...convert all at once...
+	scratch.times.resize(scratch.METs.size());
+	conv.toUTC(scratch.METs.data(), scratch.METs.size(), scratch.times.data());
+
+	// ...and format, in line order
+	const size_t cap = format ? std::max(format->length(), static_cast<size_t>(FORMAT_BUFFER_SIZE)) : FORMAT_BUFFER_SIZE;
+	size_t next = 0;
+	for (size_t i = 0; i < scratch.lines.size(); ++i) {
+		if (!scratch.valid[i]) {
+			writeInvalid(job, scratch.lines[i]);
+			continue;
+		}
+
+		char* out = reserve(job, cap + 1);
+		size_t len = format ? format->format(scratch.times[next], out, cap) : scratch.times[next].format(out, cap);
+		++next;
+		out[len++] = '\n';
+		job.outLen += len;
+	}
+}
+
+static void convertToMET(Job& job, Scratch& scratch, const TimeConverter& conv, const TimeContext& context) {
+	std::string_view text = job.chunk.text, line;
+	while (nextLine(text, line)) {
+		line = trim(line);
+		smart_tm time;
+		const bool valid = smart_tm::parse(line.data(), line.data() + line.size(), time, context) == line.data() + line.size();
+		scratch.lines.push_back(line);
+		scratch.valid.push_back(valid);
+		if (valid) scratch.times.push_back(time);
+	}
+
+	scratch.METs.resize(scratch.times.size());
+	conv.toMET(scratch.times.data(), scratch.times.size(), scratch.METs.data());
+
+	size_t next = 0;
+	for (size_t i = 0; i < scratch.lines.size(); ++i) {
+		if (!scratch.valid[i]) {
+			writeInvalid(job, scratch.lines[i]);
+			continue;
+		}
+
+		// shortest text that reads back as the same double
+		char* out = reserve(job, FORMAT_BUFFER_SIZE + 1);
+		const std::to_chars_result result = std::to_chars(out, out + FORMAT_BUFFER_SIZE, scratch.METs[next++]);
+		*result.ptr = '\n';
+		job.outLen += result.ptr + 1 - out;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		usage(argv[0]);
+		return EXIT_USAGE;
+	}
+
+	const std::shared_ptr<const TimeContext> context = opts.leapFile.empty() ? TimeContext::create(opts.epochYr) : TimeContext::create(opts.epochYr, opts.leapFile);
+	if (!context) return EXIT_USAGE;
+
+	smart_tm launch(*context);
+	if (!smart_tm::parse(opts.launch, launch, *context)) {
+		std::cerr << "ERROR: Invalid launch time " << opts.launch << '.' << std::endl;
+		return EXIT_USAGE;
+	}
+	const TimeConverter conv(launch, context);
+
+	std::unique_ptr<TimeFormat> format;
+	if (!opts.pattern.empty()) format.reset(new TimeFormat(opts.pattern));
+
+	std::unique_ptr<LineReader> reader(opts.input.empty() ? new LineReader(std::cin, opts.chunkSize) : new LineReader(opts.input, opts.chunkSize));
+	if (!reader->isOpen()) {
+		std::cerr << "ERROR: Failed to open " << opts.input << '.' << std::endl;
+		return EXIT_USAGE;
+	}
+
+	FILE* out = opts.output.empty() ? stdout : fopen(opts.output.c_str(), "wb");
+	if (!out) {
+		std::cerr << "ERROR: Failed to open " << opts.output << '.' << std::endl;
+		return EXIT_USAGE;
+	}
+	setvbuf(out, nullptr, _IOFBF, OUTPUT_BUFFER_SIZE);
+
+	// the pool of chunks in circulation, plus room for one
+	// end-of-input marker per converter in each queue
+	const size_t poolSize = opts.threads * CHUNKS_PER_THREAD;
+	BoundedQueue<JobPtr> freeJobs(poolSize), toConvert(poolSize + opts.threads), toWrite(poolSize + opts.threads);
+	for (size_t i = 0; i < poolSize; ++i) {
+		JobPtr job(new Job);
+		freeJobs.push(job);
+	}
+
+	// writer: put chunks back in order and write them out
+	size_t invalidLines = 0;
+	bool writeFailed = false;
+	std::thread writer([&] {
+		std::map<size_t, JobPtr> pending;
+		size_t nextIndex = 0, convertersDone = 0;
+		JobPtr job;
+		while (convertersDone < opts.threads) {
+			toWrite.pop(job);
+			if (job->last) {
+				++convertersDone;
+				continue;
+			}
+
+			const size_t index = job->chunk.index;
+			pending[index] = std::move(job);
+			for (auto it = pending.begin(); it != pending.end() && it->first == nextIndex; it = pending.erase(it), ++nextIndex) {
+				if (fwrite(it->second->out.data(), 1, it->second->outLen, out) != it->second->outLen) writeFailed = true;
+				invalidLines += it->second->invalidLines;
+				freeJobs.push(it->second);
+			}
+		}
+	});
+
+	// converters
+	std::vector<std::thread> converters;
+	for (size_t t = 0; t < opts.threads; ++t) {
+		converters.push_back(std::thread([&] {
+			Scratch scratch;
+			JobPtr job;
+			for (;;) {
+				toConvert.pop(job);
+				if (job->last) {
+					toWrite.push(job);
+					return;
+				}
+
+				job->outLen = 0;
+				job->invalidLines = 0;
+				scratch.lines.clear();
+				scratch.valid.clear();
+				scratch.METs.clear();
+				scratch.times.clear();
+				if (opts.toUTC) convertToUTC(*job, scratch, conv, format.get());
+				else convertToMET(*job, scratch, conv, *context);
+				toWrite.push(job);
+			}
+		}));
+	}
+
+	// reader, on this thread
+	JobPtr job;
+	for (;;) {
+		freeJobs.pop(job);
+		if (!reader->getNextChunk(job->chunk)) break;
+		toConvert.push(job);
+	}
+	for (size_t t = 0; t < opts.threads; ++t) {
+		JobPtr last(new Job);
+		last->last = true;
+		toConvert.push(last);
+	}
+
+	for (std::thread& converter : converters) converter.join();
+	writer.join();
+
+	if (fflush(out) != 0 || writeFailed) {
+		std::cerr << "ERROR: Failed to write output." << std::endl;
+		return EXIT_USAGE;
+	}
+	if (out != stdout) fclose(out);
+
+	if (invalidLines) {
+		std::cerr << "WARN: " << invalidLines << " line(s) could not be converted." << std::endl;
+		return EXIT_INVALID_LINES;
+	}
+	return EXIT_SUCCESS;
+}
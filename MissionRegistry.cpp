@@ -0,0 +1,33 @@
+/*******************************************************************
+*   MissionRegistry.cpp
+*	Many missions' MET conversions against one leap table
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include "MissionRegistry.h"
+
+MissionRegistry::MissionRegistry(const std::shared_ptr<const TimeContext>& context /* =TimeContext::sharedDefault() */)
+	: context(context) {}
+
+const TimeConverter* MissionRegistry::add(const std::string& name, const smart_tm& missionStartTM) {
+	if (byName.count(name)) return nullptr;
+	missions.push_back(Mission{ name, TimeConverter(missionStartTM, context) });
+	byName.emplace(name, missions.size() - 1);
+	return &missions.back().converter;
+}
+
+const TimeConverter* MissionRegistry::add(const std::string& name, const size_t sinceEpoch, const double sinceEpochFracSec) {
+	if (byName.count(name)) return nullptr;
+	missions.push_back(Mission{ name, TimeConverter(sinceEpoch, sinceEpochFracSec, context) });
+	byName.emplace(name, missions.size() - 1);
+	return &missions.back().converter;
+}
+
+const TimeConverter* MissionRegistry::find(const std::string& name) const {
+	const std::unordered_map<std::string, size_t>::const_iterator it = byName.find(name);
+	return it == byName.end() ? nullptr : &missions[it->second].converter;
+}
@@ -0,0 +1,82 @@
+/*******************************************************************
+*   MissionRegistry.h
+*	Many missions' MET conversions against one leap table
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Holds the TimeConverters of any number of missions or instruments,
+// by name, all converting against one shared context, so the leap table
+// exists once however many missions there are; each converter adds only
+// its mission start and the METs of the leap seconds after it.
+//
+// Missions are kept in the order they were added, and iterating over
+// them is a walk over contiguous blocks. References to missions stay
+// valid as more are added. Adding is not thread-safe, but any number of
+// threads may convert or look up at once otherwise.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+MissionRegistry missions;
+missions.add("GLAST", smart_tm(2001, 1, 1, 0, 0, 0, 0.0));
+missions.add("RXTE", smart_tm(1994, 1, 1, 0, 0, 0, 0.0));
+
+const TimeConverter* conv = missions.find("GLAST");
+if (conv) std::cout << conv->toUTC(488000000.0) << std::endl;
+
+for (const MissionRegistry::Mission& mission : missions) {
+	std::cout << mission.name << ": " << mission.converter.toMET(event) << std::endl;
+}
+
+*/
+
+#ifndef MISSION_REGISTRY_H
+#define MISSION_REGISTRY_H
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+#include "UTC_MET.h"
+
+class MissionRegistry {
+public:
+	struct Mission {
+		std::string name;
+		TimeConverter converter;
+	};
+
+	typedef std::deque<Mission>::const_iterator const_iterator;
+
+	// Every mission converts against the given context (which must not be
+	// null); by default, the default context at construction
+	explicit MissionRegistry(const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault());
+
+	// Add a mission with the given start (MET 0). Returns its converter,
+	// or nullptr, adding nothing, if the name is already taken.
+	const TimeConverter* add(const std::string& name, const smart_tm& missionStartTM);
+	const TimeConverter* add(const std::string& name, const size_t sinceEpoch, const double sinceEpochFracSec);
+
+	// The converter of the named mission, or nullptr if there is none
+	const TimeConverter* find(const std::string& name) const;
+
+	size_t size() const { return missions.size(); }
+	const Mission& operator[](const size_t i) const { return missions[i]; }
+
+	const_iterator begin() const { return missions.begin(); }
+	const_iterator end() const { return missions.end(); }
+
+	const std::shared_ptr<const TimeContext>& timeContext() const { return context; }
+
+private:
+	std::shared_ptr<const TimeContext> context;
+	std::deque<Mission> missions;
+	std::unordered_map<std::string, size_t> byName;
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*******************************************************************
+*   ParallelConvert.cpp
+*	Multi-core bulk conversion over in-memory arrays
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Splits large MET <-> UTC and toEpoch() conversions across cores.
+//
+// The input is cut into fixed-size chunks, and the threads of a
+// ThreadPool (plus the calling thread) each claim the next unconverted
+// chunk until none are left, so faster threads simply take more chunks.
+// Each chunk goes through the single-threaded batch calls, so results
+// match them element for element. All threads read the same immutable
+// TimeContext, so no locking or copying of leap tables is needed.
+
+#include "ParallelConvert.h"
+
+ThreadPool::ThreadPool(const size_t threads /* =0 */)
+	: task(nullptr), count(0), next(0), generation(0), helpersWanted(0), helpersActive(0), stopping(false) {
+	const size_t total = threads ? threads : std::max(std::thread::hardware_concurrency(), 1U);
+	for (size_t i = 1; i < total; ++i) workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers) worker.join();
+}
+
+ThreadPool& ThreadPool::getDefault() {
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::work() {
+	for (;;) {
+		const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+		if (i >= count) return;
+		(*task)(i);
+	}
+}
+
+void ThreadPool::workerLoop() {
+	size_t seen = 0;
+	std::unique_lock<std::mutex> guard(lock);
+	for (;;) {
+		// a new run that still wants helpers, or shutdown
+		wake.wait(guard, [&] { return stopping || (generation != seen && helpersWanted > 0); });
+		if (stopping) return;
+
+		seen = generation;
+		--helpersWanted;
+		++helpersActive;
+
+		guard.unlock();
+		work();
+		guard.lock();
+
+		if (--helpersActive == 0) finished.notify_all();
+	}
+}
+
+void ThreadPool::run(const size_t count, const std::function<void(size_t)>& task, const size_t maxThreads /* =0 */) {
+	if (count == 0) return;
+
+	std::lock_guard<std::mutex> serial(runLock);
+
+	const size_t threads = std::min(maxThreads ? maxThreads : size(), std::min(size(), count));
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		this->task = &task;
+		this->count = count;
+		next.store(0, std::memory_order_relaxed);
+		helpersWanted = threads - 1;
+		++generation;
+	}
+	if (threads > 1) wake.notify_all();
+
+	work();
+
+	// every task has been claimed; wait for those still running,
+	// and stop any late helpers from joining
+	std::unique_lock<std::mutex> guard(lock);
+	helpersWanted = 0;
+	finished.wait(guard, [&] { return helpersActive == 0; });
+}
+
+void toUTCParallel(const TimeConverter& conv, const double* METs, const size_t n, smart_tm* timesOut, const ParallelOptions& opts /* =ParallelOptions() */) {
+	forEachChunk(n, opts, [&](const size_t begin, const size_t count) {
+		conv.toUTC(METs + begin, count, timesOut + begin);
+	});
+}
+
+void toUTCParallel(const TimeConverter& conv, const double* METs, const size_t n, const UTCColumns& timesOut, const ParallelOptions& opts /* =ParallelOptions() */) {
+	forEachChunk(n, opts, [&](const size_t begin, const size_t count) {
+		// the same columns, from this chunk's first element
+		const UTCColumns chunkOut = {
+			timesOut.yr ? timesOut.yr + begin : nullptr,
+			timesOut.mon ? timesOut.mon + begin : nullptr,
+			timesOut.day ? timesOut.day + begin : nullptr,
+			timesOut.hr ? timesOut.hr + begin : nullptr,
+			timesOut.min ? timesOut.min + begin : nullptr,
+			timesOut.sec ? timesOut.sec + begin : nullptr,
+			timesOut.fracSec ? timesOut.fracSec + begin : nullptr
+		};
+		conv.toUTC(METs + begin, count, chunkOut);
+	});
+}
+
+void toMETParallel(const TimeConverter& conv, const smart_tm* times, const size_t n, double* METsOut, const ParallelOptions& opts /* =ParallelOptions() */) {
+	forEachChunk(n, opts, [&](const size_t begin, const size_t count) {
+		conv.toMET(times + begin, count, METsOut + begin);
+	});
+}
+
+void toEpochParallel(const smart_tm* times, const size_t n, size_t* epochsOut, double* fracSecsOut, const TimeContext& context /* =TimeContext::getDefault() */, const ParallelOptions& opts /* =ParallelOptions() */) {
+	forEachChunk(n, opts, [&](const size_t begin, const size_t count) {
+		size_t leapHint = 0;
+		for (size_t i = begin; i < begin + count; ++i) {
+			epochsOut[i] = times[i].toEpoch(fracSecsOut[i], leapHint, context);
+		}
+	});
+}
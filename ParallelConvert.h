@@ -0,0 +1,142 @@
+/*******************************************************************
+*   ParallelConvert.h
+*	Multi-core bulk conversion over in-memory arrays
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Splits large MET <-> UTC and toEpoch() conversions across cores.
+//
+// The input is cut into fixed-size chunks, and the threads of a
+// ThreadPool (plus the calling thread) each claim the next unconverted
+// chunk until none are left, so faster threads simply take more chunks.
+// Each chunk goes through the single-threaded batch calls, so results
+// match them element for element. All threads read the same immutable
+// TimeContext, so no locking or copying of leap tables is needed.
+//
+// By default, calls use a shared pool with one thread per core,
+// created on first use. Pass a ParallelOptions to choose the pool,
+// limit the number of threads used, or change the chunk size.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+TimeConverter conv(smart_tm(2008, 6, 11, 16, 5, 0, 0.0));
+
+std::vector<double> METs = ...;
+std::vector<smart_tm> times(METs.size());
+toUTCParallel(conv, METs.data(), METs.size(), times.data());
+
+ParallelOptions opts;
+opts.threads = 16;
+toMETParallel(conv, times.data(), times.size(), METs.data(), opts);
+
+*/
+
+#ifndef PARALLEL_CONVERT_H
+#define PARALLEL_CONVERT_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "smart_tm.h"
+#include "UTC_MET.h"
+
+// elements per chunk by default; large enough that claiming a chunk
+// costs nothing next to converting it, small enough to balance load
+#define DEFAULT_PARALLEL_CHUNK		(16384)
+
+class ThreadPool {
+public:
+	// Start a pool of threads, which with the calling thread make
+	// 'threads' in all (0 for one per core)
+	explicit ThreadPool(const size_t threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Threads available to run(), counting the calling thread
+	size_t size() const { return workers.size() + 1; }
+
+	// Run task(0) to task(count - 1) on up to maxThreads threads
+	// (0 for all of them), including the calling thread, and return
+	// once all have finished. One run() at a time per pool; others wait.
+	// Tasks must not call run() on the same pool.
+	void run(const size_t count, const std::function<void(size_t)>& task, const size_t maxThreads = 0);
+
+	// The shared pool used by default, one thread per core
+	static ThreadPool& getDefault();
+
+private:
+	void workerLoop();
+
+	// claim and run tasks until there are none left
+	void work();
+
+	std::vector<std::thread> workers;
+
+	std::mutex runLock;
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable finished;
+
+	// the current run
+	const std::function<void(size_t)>* task;
+	size_t count;
+	std::atomic<size_t> next;
+	size_t generation;
+	size_t helpersWanted;
+	size_t helpersActive;
+	bool stopping;
+};
+
+struct ParallelOptions {
+	// pool to run on, or nullptr for ThreadPool::getDefault()
+	ThreadPool* pool;
+
+	// most threads to use, or 0 for the whole pool
+	size_t threads;
+
+	// elements per chunk, or 0 for DEFAULT_PARALLEL_CHUNK
+	size_t chunkSize;
+
+	ParallelOptions() : pool(nullptr), threads(0), chunkSize(0) {}
+};
+
+// Run convert(begin, count) over consecutive chunks of [0, n) on the
+// threads of opts, as the calls below do; for conversions of one's own
+template <typename Convert>
+void forEachChunk(const size_t n, const ParallelOptions& opts, const Convert& convert) {
+	ThreadPool& pool = opts.pool ? *opts.pool : ThreadPool::getDefault();
+	const size_t chunkSize = opts.chunkSize ? opts.chunkSize : DEFAULT_PARALLEL_CHUNK;
+	const size_t chunks = (n + chunkSize - 1) / chunkSize;
+
+	pool.run(chunks, [&](const size_t chunk) {
+		const size_t begin = chunk * chunkSize;
+		convert(begin, std::min(chunkSize, n - begin));
+	}, opts.threads);
+}
+
+// TimeConverter::toUTC(METs, n, timesOut), in parallel
+void toUTCParallel(const TimeConverter& conv, const double* METs, const size_t n, smart_tm* timesOut, const ParallelOptions& opts = ParallelOptions());
+
+// TimeConverter::toUTC(METs, n, timesOut) into columns, in parallel
+void toUTCParallel(const TimeConverter& conv, const double* METs, const size_t n, const UTCColumns& timesOut, const ParallelOptions& opts = ParallelOptions());
+
+// TimeConverter::toMET(times, n, METsOut), in parallel
+void toMETParallel(const TimeConverter& conv, const smart_tm* times, const size_t n, double* METsOut, const ParallelOptions& opts = ParallelOptions());
+
+// times[i].toEpoch(fracSecsOut[i], context) into epochsOut[i], in parallel
+void toEpochParallel(const smart_tm* times, const size_t n, size_t* epochsOut, double* fracSecsOut, const TimeContext& context = TimeContext::getDefault(), const ParallelOptions& opts = ParallelOptions());
+
+#endif
@@ -0,0 +1,410 @@
+/*******************************************************************
+*   SmartTimeBench.cpp
+*	Microbenchmarks of the Smart Time System hot paths
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Times toEpoch(), adjust() with small and large, positive and negative
+// deltas and with adversarial deltas (below), the sinceEpoch
+// constructor, TimeConverter::toMET() and toUTC(), operator<,
+// operator-, toString() and init(), reporting nanoseconds and heap
+// allocations per operation.
+//
+// Every benchmark is run once per year range and leap second distance:
+//	any		times drawn uniformly from the year range
+//	near	times within +-W seconds of a leap second in the range
+//			(skipped for ranges without leap seconds)
+// so regressions in the leap-aware paths show up separately from the
+// common case.
+//
+// The adversarial adjust() cases put huge values of either sign into
+// one or several fields at once, including ones that cancel out (a
+// trillion days forward and as many days' worth of seconds back), as
+// an untrusted input file could. adjust() is constant time, so none of
+// them should cost much more than a small delta; the worst of them is
+// reported on its own line. Allocations are counted by replacing the global
+// operator new.
+//
+// Standalone, with no dependencies beyond the Smart Time System itself.
+// Build with optimization, for example:
+/*
+
+g++ -O2 -std=c++17 -pthread -o SmartTimeBench SmartTimeBench.cpp smart_tm.cpp TimeContext.cpp UTC_MET.cpp CivilSIMD.cpp FileIO.cpp
+
+*/
+//
+// Example use:
+/*
+
+SmartTimeBench
+SmartTimeBench -y 1972-2017,2017-2100 -w 5 -m 500 -f csv > bench.csv
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "UTC_MET.h"
+#include "smart_tm.h"
+
+#define DEFAULT_INPUTS				(4096)
+#define DEFAULT_MIN_MS				(200)
+#define DEFAULT_LEAP_WINDOW			(60)
+
+// init() publishes a new default context every call, and published
+// contexts are kept alive, so it gets a fixed count instead of a minimum time
+#define INIT_ITERATIONS				(1000)
+
+// deltas added to the seconds field before adjust()
+#define SMALL_DELTA					(100)
+#define LARGE_DELTA_MIN				(1000000LL)
+#define LARGE_DELTA_MAX				(1000000000LL)
+
+// magnitude of the adversarial field values; a trillion days worth of
+// seconds still fits a long long many times over
+#define HUGE_DELTA					(1000000000000LL)
+
+#define EXIT_USAGE					(2)
+
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+struct YearRange {
+	long long from;
+	long long to;
+};
+
+struct Options {
+	long long epochYr;
+	std::string leapFile;
+	std::vector<YearRange> ranges;
+	long long leapWindow;
+	size_t inputs;
+	double minSeconds;
+	bool csv;
+};
+
+struct Result {
+	double nsPerOp;
+	double allocsPerOp;
+};
+
+// results fold into here so no benchmarked call can be optimized away
+static volatile size_t sink;
+
+static void usage(const char* name) {
+	std::cerr << "Usage: " << name << " [options]" << std::endl
+		<< "  -e YEAR      epoch year (default " << DEFAULT_EPOCH_YEAR << ")" << std::endl
+		<< "  -l FILE      leap second file (default: built-in table)" << std::endl
+		<< "  -y RANGES    year ranges, e.g. 1972-2017,2017-2100 (default as this example)" << std::endl
+		<< "  -w SECONDS   'near' leap second window (default " << DEFAULT_LEAP_WINDOW << ")" << std::endl
+		<< "  -n COUNT     inputs per benchmark (default " << DEFAULT_INPUTS << ")" << std::endl
+		<< "  -m MS        minimum time per benchmark (default " << DEFAULT_MIN_MS << ")" << std::endl
+		<< "  -f FORMAT    table or csv (default table)" << std::endl;
+}
+
+static bool parseRanges(const std::string& text, std::vector<YearRange>& ranges) {
+	ranges.clear();
+	const char* p = text.c_str();
+	while (*p) {
+		char* end;
+		YearRange range;
+		range.from = strtoll(p, &end, BASE_10_PLEASE);
+		if (end == p || *end != '-') return false;
+		p = end + 1;
+		range.to = strtoll(p, &end, BASE_10_PLEASE);
+		if (end == p || range.to <= range.from) return false;
+		ranges.push_back(range);
+		p = end;
+		if (*p == ',') ++p;
+		else if (*p) return false;
+	}
+	return !ranges.empty();
+}
+
+static bool parseOptions(const int argc, char* argv[], Options& opts) {
+	opts.epochYr = DEFAULT_EPOCH_YEAR;
+	opts.leapWindow = DEFAULT_LEAP_WINDOW;
+	opts.inputs = DEFAULT_INPUTS;
+	opts.minSeconds = DEFAULT_MIN_MS / 1000.0;
+	opts.csv = false;
+	parseRanges("1972-2017,2017-2100", opts.ranges);
+
+	for (int i = 1; i < argc; i += 2) {
+		const std::string flag = argv[i];
+		if (i + 1 >= argc || flag.size() != 2 || flag[0] != '-') return false;
+
+		const std::string value = argv[i + 1];
+		switch (flag[1]) {
+		case 'e': opts.epochYr = strtoll(value.c_str(), nullptr, BASE_10_PLEASE); break;
+		case 'l': opts.leapFile = value; break;
+		case 'y': if (!parseRanges(value, opts.ranges)) return false; break;
+		case 'w': opts.leapWindow = std::max(strtoll(value.c_str(), nullptr, BASE_10_PLEASE), 0LL); break;
+		case 'n': opts.inputs = std::max(strtoull(value.c_str(), nullptr, BASE_10_PLEASE), 2ULL); break;
+		case 'm': opts.minSeconds = std::max(strtoull(value.c_str(), nullptr, BASE_10_PLEASE), 1ULL) / 1000.0; break;
+		case 'f':
+			if (value != "table" && value != "csv") return false;
+			opts.csv = (value == "csv");
+			break;
+		default: return false;
+		}
+	}
+
+	for (const YearRange& range : opts.ranges) {
+		if (range.from < opts.epochYr || range.to > END_YR) return false;
+	}
+	return true;
+}
+
+// Run op(i) over every input until at least minSeconds have passed,
+// after one untimed warm-up pass
+template <typename Op>
+static Result measure(const size_t n, const double minSeconds, const Op op) {
+	size_t check = 0;
+	for (size_t i = 0; i < n; ++i) check += op(i);
+
+	size_t passes = 0;
+	const size_t allocsBefore = allocations.load(std::memory_order_relaxed);
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	double elapsed;
+	do {
+		for (size_t i = 0; i < n; ++i) check += op(i);
+		++passes;
+		elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	} while (elapsed < minSeconds);
+	const size_t allocs = allocations.load(std::memory_order_relaxed) - allocsBefore;
+	sink = check;
+
+	const double ops = static_cast<double>(passes) * static_cast<double>(n);
+	Result result;
+	result.nsPerOp = elapsed * 1e9 / ops;
+	result.allocsPerOp = static_cast<double>(allocs) / ops;
+	return result;
+}
+
+static void report(const Options& opts, const std::string& name, const YearRange& range, const char* distance, const Result& result) {
+	if (opts.csv) {
+		printf("%s,%lld-%lld,%s,%.2f,%.3f\n", name.c_str(), range.from, range.to, distance, result.nsPerOp, result.allocsPerOp);
+	}
+	else {
+		printf("%-22s %4lld-%-4lld  %-4s  %10.2f  %10.3f\n", name.c_str(), range.from, range.to, distance, result.nsPerOp, result.allocsPerOp);
+	}
+	fflush(stdout);
+}
+
+// Seconds since epoch of inputs for one benchmark case: uniform over
+// [start, end), or within +-window of a random leap second in it
+static std::vector<size_t> makeEpochs(const size_t n, const size_t start, const size_t end, const std::vector<size_t>& leaps, const long long window, std::mt19937_64& rng) {
+	std::vector<size_t> epochs(n);
+	for (size_t i = 0; i < n; ++i) {
+		if (leaps.empty()) {
+			epochs[i] = start + rng() % (end - start);
+		}
+		else {
+			const long long offset = static_cast<long long>(rng() % static_cast<size_t>(2 * window + 1)) - window;
+			const long long epoch = static_cast<long long>(leaps[rng() % leaps.size()]) + offset;
+			epochs[i] = static_cast<size_t>(std::min(std::max(epoch, static_cast<long long>(start)), static_cast<long long>(end) - 1));
+		}
+	}
+	return epochs;
+}
+
+static void runCase(const Options& opts, const TimeContext& context, const YearRange& range, const char* distance, const std::vector<size_t>& epochs, std::mt19937_64& rng) {
+	const size_t n = epochs.size();
+	const double minSeconds = opts.minSeconds;
+
+	std::vector<double> fracs(n);
+	std::vector<smart_tm> times;
+	times.reserve(n);
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+	for (size_t i = 0; i < n; ++i) {
+		fracs[i] = unit(rng);
+		times.push_back(smart_tm(epochs[i], fracs[i]));
+	}
+
+	std::vector<long long> smallDeltas(n), largeDeltas(n);
+	for (size_t i = 0; i < n; ++i) {
+		smallDeltas[i] = 1 + static_cast<long long>(rng() % SMALL_DELTA);
+		largeDeltas[i] = LARGE_DELTA_MIN + static_cast<long long>(rng() % static_cast<size_t>(LARGE_DELTA_MAX - LARGE_DELTA_MIN));
+	}
+
+	// mission starts at the beginning of the range
+	const TimeConverter conv(smart_tm(range.from, START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC));
+	std::vector<double> METs(n);
+	for (size_t i = 0; i < n; ++i) METs[i] = conv.toMET(times[i]);
+
+	report(opts, "toEpoch", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		double fracSec;
+		return times[i].toEpoch(fracSec, context);
+	}));
+
+	const struct {
+		const char* name;
+		const std::vector<long long>& deltas;
+		long long sign;
+	} adjustCases[] = {
+		{ "adjust +small", smallDeltas, 1 },
+		{ "adjust -small", smallDeltas, -1 },
+		{ "adjust +large", largeDeltas, 1 },
+		{ "adjust -large", largeDeltas, -1 },
+	};
+	for (const auto& adjustCase : adjustCases) {
+		// negative large deltas could land before epoch; skip those inputs
+		report(opts, adjustCase.name, range, distance, measure(n, minSeconds, [&](const size_t i) {
+			smart_tm time = times[i];
+			const long long delta = adjustCase.sign * adjustCase.deltas[i];
+			if (static_cast<long long>(epochs[i]) + delta < 0) return static_cast<size_t>(0);
+			time.sec += delta;
+			time.adjust(context);
+			return static_cast<size_t>(time.sec + time.day);
+		}));
+	}
+
+	// each adversarial case sets fields of a time to huge values that
+	// cancel out, leaving it within a day after where it was, or
+	// (the "+" cases) pushes it millions of years ahead
+	std::vector<long long> hugeDeltas(n);
+	for (size_t i = 0; i < n; ++i) {
+		hugeDeltas[i] = static_cast<long long>(rng() % static_cast<size_t>(2 * HUGE_DELTA + 1)) - HUGE_DELTA;
+	}
+
+	const struct {
+		const char* name;
+		void (*apply)(smart_tm& time, const long long delta);
+	} worstCases[] = {
+		{ "adjust sec/day huge", [](smart_tm& time, const long long delta) { time.sec += delta * SECONDS_PER_DAY + 7; time.day -= delta; } },
+		{ "adjust min/day huge", [](smart_tm& time, const long long delta) { time.min -= delta * MINUTES_PER_HOUR * HOURS_PER_DAY; time.day += delta; } },
+		{ "adjust hr/day huge", [](smart_tm& time, const long long delta) { time.hr += delta * HOURS_PER_DAY; time.day -= delta - 1; } },
+		{ "adjust mon/yr huge", [](smart_tm& time, const long long delta) { time.mon -= delta * MONTHS_PER_YEAR; time.yr += delta; } },
+		{ "adjust all huge", [](smart_tm& time, const long long delta) {
+			time.sec -= delta * SECONDS_PER_HOUR;
+			time.min += delta * MINUTES_PER_HOUR;
+			time.hr -= delta * HOURS_PER_DAY;
+			time.day += delta + 1;
+			time.fracSec += 2.5;
+		} },
+		{ "adjust +day huge", [](smart_tm& time, const long long delta) { time.day += (delta < 0 ? -delta : delta) / 1000; } },
+		{ "adjust +sec huge", [](smart_tm& time, const long long delta) { time.sec += (delta < 0 ? -delta : delta) * 100; } },
+	};
+	Result worst = { 0.0, 0.0 };
+	for (const auto& worstCase : worstCases) {
+		const Result result = measure(n, minSeconds, [&](const size_t i) {
+			smart_tm time = times[i];
+			worstCase.apply(time, hugeDeltas[i]);
+			time.adjust(context);
+			return static_cast<size_t>(time.sec + time.day);
+		});
+		report(opts, worstCase.name, range, distance, result);
+		if (result.nsPerOp > worst.nsPerOp) worst = result;
+	}
+	report(opts, "adjust worst case", range, distance, worst);
+
+	report(opts, "smart_tm(sinceEpoch)", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		const smart_tm time(epochs[i], fracs[i], context);
+		return static_cast<size_t>(time.sec + time.day);
+	}));
+
+	report(opts, "TimeConverter::toMET", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		return static_cast<size_t>(conv.toMET(times[i]));
+	}));
+
+	report(opts, "TimeConverter::toUTC", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		const smart_tm time = conv.toUTC(METs[i]);
+		return static_cast<size_t>(time.sec + time.day);
+	}));
+
+	report(opts, "operator<", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		return static_cast<size_t>(times[i] < times[(i + 1) % n]);
+	}));
+
+	report(opts, "operator-", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		return static_cast<size_t>(times[i] - times[(i + 1) % n]);
+	}));
+
+	report(opts, "toString", range, distance, measure(n, minSeconds, [&](const size_t i) {
+		return times[i].toString().size();
+	}));
+}
+
+int main(int argc, char* argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		usage(argv[0]);
+		return EXIT_USAGE;
+	}
+
+	if (opts.leapFile.empty()) {
+		smart_tm::init(opts.epochYr);
+	}
+	else {
+		smart_tm::init(opts.epochYr, opts.leapFile);
+	}
+	const std::shared_ptr<const TimeContext> context = TimeContext::sharedDefault();
+	if (!context->initialized()) return EXIT_USAGE;
+
+	if (opts.csv) {
+		printf("benchmark,years,leap_distance,ns_per_op,allocs_per_op\n");
+	}
+	else {
+		printf("%-22s %-9s  %-4s  %10s  %10s\n", "benchmark", "years", "leap", "ns/op", "allocs/op");
+	}
+
+	std::mt19937_64 rng(0);
+	for (const YearRange& range : opts.ranges) {
+		const size_t start = smart_tm(range.from, START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC).toEpoch(*context);
+		const size_t end = smart_tm(range.to, START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC).toEpoch(*context);
+
+		std::vector<size_t> leaps;
+		for (const size_t leap : context->leapSecondEpochs()) {
+			if (leap >= start && leap < end) leaps.push_back(leap);
+		}
+
+		runCase(opts, *context, range, "any", makeEpochs(opts.inputs, start, end, std::vector<size_t>(), 0, rng), rng);
+		if (!leaps.empty()) runCase(opts, *context, range, "near", makeEpochs(opts.inputs, start, end, leaps, opts.leapWindow, rng), rng);
+	}
+
+	// init() does not depend on the inputs; time it once, restoring
+	// the benchmark's own default context afterwards
+	size_t check = 0;
+	const size_t allocsBefore = allocations.load(std::memory_order_relaxed);
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < INIT_ITERATIONS; ++i) {
+		if (opts.leapFile.empty()) {
+			smart_tm::init(opts.epochYr);
+		}
+		else {
+			smart_tm::init(opts.epochYr, opts.leapFile);
+		}
+		check += smart_tm::leapSecondEpochs().size();
+	}
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	sink = check;
+	TimeContext::setDefault(context);
+
+	Result result;
+	result.nsPerOp = elapsed * 1e9 / INIT_ITERATIONS;
+	result.allocsPerOp = static_cast<double>(allocations.load(std::memory_order_relaxed) - allocsBefore) / INIT_ITERATIONS;
+	const YearRange all = { opts.epochYr, END_YR };
+	report(opts, opts.leapFile.empty() ? "init (built-in)" : "init (leap file)", all, "-", result);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,506 @@
+/*******************************************************************
+*   SmartTimePy.cpp
+*	Python bindings over the batch conversion calls
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// A CPython extension module, 'smarttime', exposing TimeConverter's
+// batch MET -> UTC conversion and smart_instant to Python a whole array
+// at a time, so Python overhead is paid once per call rather than once
+// per timestamp.
+//
+// Input arrays are read in place via the buffer protocol, so any
+// C-contiguous, one-dimensional NumPy array (or array.array, memoryview,
+// ...) of the right type works with no copy and no per-element Python
+// objects. Results are new smarttime.Array objects, which export their
+// storage the same way, so numpy.asarray() wraps them without a copy.
+// Conversions run with the GIL released, across every core by default
+// (see ParallelConvert.h), or on 'threads' threads if given.
+//
+// The module has no build-time dependency on NumPy. Types:
+//	METs			float64
+//	times			int64 year, month, day, hour, minute and second
+//					columns, plus float64 fractional seconds
+//	datetime64		int64 nanoseconds since 1970-01-01, as
+//					numpy.datetime64[ns]; a leap second becomes the
+//					next second, as in Unix time
+//	instants		16-byte smart_instants as the structured dtype
+//					[('since_epoch', '<i8'), ('frac', '<u8')]
+// METs must be at or after the mission start (not negative) and below
+// 2^53, and datetime64 results within its range (years 1678 to 2262);
+// a ValueError is raised otherwise, as for NaN.
+//
+// Build, for example:
+/*
+
+g++ -O2 -std=c++17 -pthread -shared -fPIC $(python3-config --includes) -o smarttime$(python3-config --extension-suffix) SmartTimePy.cpp smart_tm.cpp TimeContext.cpp UTC_MET.cpp CivilSIMD.cpp ParallelConvert.cpp FileIO.cpp smart_instant.cpp smart_clock.cpp
+
+*/
+//
+// Example use:
+/*
+
+import numpy as np
+import smarttime
+
+smarttime.init(1990, "leap-seconds.list")
+conv = smarttime.Converter(2001, 1, 1)
+
+METs = np.array([0.0, 362793601.5, 488000000.25])
+year, month, day, hour, minute, second, frac = (np.asarray(a) for a in conv.to_utc(METs))
+stamps = np.asarray(conv.to_datetime64(METs)).view("datetime64[ns]")
+instants = np.asarray(conv.to_instants(METs))
+assert (np.asarray(conv.to_met(instants)) == METs).all()
+
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "ParallelConvert.h"
+#include "UTC_MET.h"
+#include "smart_clock.h"
+#include "smart_instant.h"
+#include "smart_tm.h"
+
+// buffer protocol formats of the arrays the module hands out
+#define FLOAT64_FORMAT				"d"
+#define INT64_FORMAT				"q"
+#define INSTANT_FORMAT				"T{q:since_epoch:Q:frac:}"
+
+#define TIME_COLUMNS				(7)
+
+#define NANOS_PER_UNIX_SECOND		(1000000000LL)
+// largest MET whose whole seconds a float64 holds exactly
+#define MAX_MET						(9007199254740992.0)
+#define INVALID_METS_MESSAGE		"METs must be finite, not negative and below 2**53"
+
+static_assert(sizeof(smart_instant) == 16, "instants are exported as two 8-byte fields");
+
+// Array: an owned, one-dimensional block of fixed-size items,
+// exported read-write through the buffer protocol
+
+struct Array {
+	PyObject_HEAD
+	char* data;
+	Py_ssize_t length;
+	Py_ssize_t itemSize;
+	const char* format;
+};
+
+static void arrayDealloc(Array* self) {
+	free(self->data);
+	Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int arrayGetBuffer(Array* self, Py_buffer* view, const int flags) {
+	if (PyBuffer_FillInfo(view, reinterpret_cast<PyObject*>(self), self->data, self->length * self->itemSize, 0, flags) < 0) return -1;
+	view->itemsize = self->itemSize;
+	view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(self->format) : nullptr;
+	view->ndim = 1;
+	view->shape = (flags & PyBUF_ND) ? &self->length : nullptr;
+	view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &self->itemSize : nullptr;
+	return 0;
+}
+
+static Py_ssize_t arrayLength(Array* self) {
+	return self->length;
+}
+
+static PyBufferProcs arrayBufferProcs = {
+	reinterpret_cast<getbufferproc>(arrayGetBuffer),
+	nullptr
+};
+
+// value-initialized and filled in by PyInit_smarttime(), field by field
+static PySequenceMethods arraySequenceMethods = {};
+static PyTypeObject ArrayType = {};
+
+static Array* newArray(const Py_ssize_t length, const Py_ssize_t itemSize, const char* format) {
+	Array* array = PyObject_New(Array, &ArrayType);
+	if (!array) return nullptr;
+
+	array->data = static_cast<char*>(malloc(length ? length * itemSize : 1));
+	array->length = length;
+	array->itemSize = itemSize;
+	array->format = format;
+	if (!array->data) {
+		Py_DECREF(array);
+		PyErr_NoMemory();
+		return nullptr;
+	}
+	return array;
+}
+
+// Input: a borrowed, C-contiguous, one-dimensional buffer, released on destruction
+
+class Input {
+public:
+	Input() : held(false) {}
+	~Input() { if (held) PyBuffer_Release(&view); }
+
+	Input(const Input&) = delete;
+	Input& operator=(const Input&) = delete;
+
+	// Borrow obj's buffer, which must hold items of the given format
+	// character (or, for '\0', any 16-byte items). Sets a Python
+	// exception and returns false if it cannot.
+	bool get(PyObject* obj, const char type, const char* name) {
+		if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) return false;
+		held = true;
+
+		if (view.ndim != 1) {
+			PyErr_Format(PyExc_ValueError, "%s must be one-dimensional", name);
+			return false;
+		}
+		const bool matches = type ? (view.itemsize == 8 && isNative(view.format, type)) : (view.itemsize == sizeof(smart_instant));
+		if (!matches) {
+			PyErr_Format(PyExc_TypeError, "%s must be %s", name, type == 'd' ? "float64" : type ? "int64" : "16-byte instants");
+			return false;
+		}
+		return true;
+	}
+
+	Py_ssize_t size() const { return view.shape[0]; }
+	const void* data() const { return view.buf; }
+
+private:
+	// Is format the native single item 'type' (for int64, 'l' or 'q')?
+	static bool isNative(const char* format, const char type) {
+		if (!format) return false;
+		if (*format == '@' || *format == '=' || (*format == '<' && littleEndian())) ++format;
+		if (format[0] == '\0' || format[1] != '\0') return false;
+		return format[0] == type || (type == 'q' && format[0] == 'l');
+	}
+
+	static bool littleEndian() {
+		const uint16_t one = 1;
+		return *reinterpret_cast<const uint8_t*>(&one) == 1;
+	}
+
+	Py_buffer view;
+	bool held;
+};
+
+// Converter: a TimeConverter for one mission start
+
+struct Converter {
+	PyObject_HEAD
+	TimeConverter* conv;
+};
+
+static void converterDealloc(Converter* self) {
+	delete self->conv;
+	Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int converterInit(Converter* self, PyObject* args, PyObject* kwargs) {
+	static const char* keywords[] = { "year", "month", "day", "hour", "minute", "second", "frac", nullptr };
+	long long yr, mon, day, hr = START_HR, min = START_MIN, sec = START_SEC;
+	double fracSec = START_FRAC_SEC;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "LLL|LLLd", const_cast<char**>(keywords), &yr, &mon, &day, &hr, &min, &sec, &fracSec)) return -1;
+
+	const smart_tm missionStart(yr, mon, day, hr, min, sec, fracSec);
+	if (yr < TimeContext::getDefault().epochYear() || !missionStart.isValid()) {
+		PyErr_SetString(PyExc_ValueError, "mission start must be a valid time at or after epoch");
+		return -1;
+	}
+
+	delete self->conv;
+	self->conv = new (std::nothrow) TimeConverter(missionStart);
+	if (!self->conv) {
+		PyErr_NoMemory();
+		return -1;
+	}
+	return 0;
+}
+
+// Parse (array, threads=0) into opts, for a Converter that has been initialized
+static bool parseArgs(const Converter* self, PyObject* args, PyObject* kwargs, const char* name, PyObject*& array, ParallelOptions& opts) {
+	if (!self->conv) {
+		PyErr_SetString(PyExc_RuntimeError, "Converter.__init__() was not called");
+		return false;
+	}
+
+	const char* keywords[] = { name, "threads", nullptr };
+	Py_ssize_t threads = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|n", const_cast<char**>(keywords), &array, &threads)) return false;
+	if (threads < 0) {
+		PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+		return false;
+	}
+	opts.threads = static_cast<size_t>(threads);
+	return true;
+}
+
+// Run convert(begin, count) over chunks of [0, n) with the GIL released.
+// convert returns false if any of its elements could not be converted,
+// in which case this sets a ValueError with the message given and returns false.
+template <typename Convert>
+static bool convertAll(const Py_ssize_t n, const ParallelOptions& opts, const char* failure, const Convert& convert) {
+	std::atomic<bool> ok(true);
+	Py_BEGIN_ALLOW_THREADS
+	forEachChunk(static_cast<size_t>(n), opts, [&](const size_t begin, const size_t count) {
+		if (!convert(begin, count)) ok.store(false, std::memory_order_relaxed);
+	});
+	Py_END_ALLOW_THREADS
+	if (!ok.load()) PyErr_SetString(PyExc_ValueError, failure);
+	return ok.load();
+}
+
+static bool validMETs(const double* METs, const size_t count) {
+	bool valid = true;
+	for (size_t i = 0; i < count; ++i) valid &= METs[i] >= 0.0 && METs[i] < MAX_MET;
+	return valid;
+}
+
+static PyObject* converterToUTC(Converter* self, PyObject* args, PyObject* kwargs) {
+	PyObject* obj;
+	ParallelOptions opts;
+	Input METs;
+	if (!parseArgs(self, args, kwargs, "METs", obj, opts) || !METs.get(obj, 'd', "METs")) return nullptr;
+
+	const Py_ssize_t n = METs.size();
+	Array* columns[TIME_COLUMNS] = {};
+	for (size_t i = 0; i < TIME_COLUMNS; ++i) {
+		columns[i] = (i + 1 < TIME_COLUMNS) ? newArray(n, sizeof(long long), INT64_FORMAT) : newArray(n, sizeof(double), FLOAT64_FORMAT);
+		if (!columns[i]) {
+			for (size_t j = 0; j < i; ++j) Py_DECREF(columns[j]);
+			return nullptr;
+		}
+	}
+
+	const UTCColumns timesOut = {
+		reinterpret_cast<long long*>(columns[0]->data),
+		reinterpret_cast<long long*>(columns[1]->data),
+		reinterpret_cast<long long*>(columns[2]->data),
+		reinterpret_cast<long long*>(columns[3]->data),
+		reinterpret_cast<long long*>(columns[4]->data),
+		reinterpret_cast<long long*>(columns[5]->data),
+		reinterpret_cast<double*>(columns[6]->data)
+	};
+	// check every MET before converting any, as toUTC() trusts its input
+	const double* in = static_cast<const double*>(METs.data());
+	const bool ok = convertAll(n, opts, INVALID_METS_MESSAGE, [&](const size_t begin, const size_t count) {
+		return validMETs(in + begin, count);
+	});
+	if (ok) {
+		Py_BEGIN_ALLOW_THREADS
+		toUTCParallel(*self->conv, in, static_cast<size_t>(n), timesOut, opts);
+		Py_END_ALLOW_THREADS
+	}
+
+	PyObject* result = ok ? PyTuple_New(TIME_COLUMNS) : nullptr;
+	for (size_t i = 0; i < TIME_COLUMNS; ++i) {
+		if (result) PyTuple_SET_ITEM(result, i, reinterpret_cast<PyObject*>(columns[i]));
+		else Py_DECREF(columns[i]);
+	}
+	return result;
+}
+
+// Instant of a MET of conv's mission, as TimeColumnWriter::write() makes it
+static inline smart_instant METToInstant(const double MET, const long long startEpoch, const double startFracSec) {
+	const double wholeMET = floor(MET);
+	return smart_instant::fromEpoch(startEpoch + static_cast<long long>(wholeMET), startFracSec + (MET - wholeMET));
+}
+
+static PyObject* converterToInstants(Converter* self, PyObject* args, PyObject* kwargs) {
+	PyObject* obj;
+	ParallelOptions opts;
+	Input METs;
+	if (!parseArgs(self, args, kwargs, "METs", obj, opts) || !METs.get(obj, 'd', "METs")) return nullptr;
+
+	const Py_ssize_t n = METs.size();
+	Array* instants = newArray(n, sizeof(smart_instant), INSTANT_FORMAT);
+	if (!instants) return nullptr;
+
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(self->conv->missionStart(startFracSec));
+	const double* in = static_cast<const double*>(METs.data());
+	smart_instant* out = reinterpret_cast<smart_instant*>(instants->data);
+	const bool ok = convertAll(n, opts, INVALID_METS_MESSAGE, [&](const size_t begin, const size_t count) {
+		if (!validMETs(in + begin, count)) return false;
+		for (size_t i = begin; i < begin + count; ++i) out[i] = METToInstant(in[i], startEpoch, startFracSec);
+		return true;
+	});
+
+	if (!ok) {
+		Py_DECREF(instants);
+		return nullptr;
+	}
+	return reinterpret_cast<PyObject*>(instants);
+}
+
+static PyObject* converterToDatetime64(Converter* self, PyObject* args, PyObject* kwargs) {
+	PyObject* obj;
+	ParallelOptions opts;
+	Input METs;
+	if (!parseArgs(self, args, kwargs, "METs", obj, opts) || !METs.get(obj, 'd', "METs")) return nullptr;
+
+	const Py_ssize_t n = METs.size();
+	Array* stamps = newArray(n, sizeof(long long), INT64_FORMAT);
+	if (!stamps) return nullptr;
+
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(self->conv->missionStart(startFracSec));
+	const TimeContext& context = *self->conv->timeContext();
+	const double* in = static_cast<const double*>(METs.data());
+	long long* out = reinterpret_cast<long long*>(stamps->data);
+	const bool ok = convertAll(n, opts, INVALID_METS_MESSAGE " and within datetime64[ns]", [&](const size_t begin, const size_t count) {
+		if (!validMETs(in + begin, count)) return false;
+
+		const long long limit = std::numeric_limits<long long>::max() / NANOS_PER_UNIX_SECOND - 1;
+		for (size_t i = begin; i < begin + count; ++i) {
+			const smart_instant instant = METToInstant(in[i], startEpoch, startFracSec);
+			const long long unixSec = smart_clock::toUnixSeconds(instant.sinceEpoch, context);
+			if (unixSec > limit || unixSec < -limit) return false;
+			out[i] = unixSec * NANOS_PER_UNIX_SECOND + llround(instant.fracSec() * NANOS_PER_UNIX_SECOND);
+		}
+		return true;
+	});
+
+	if (!ok) {
+		Py_DECREF(stamps);
+		return nullptr;
+	}
+	return reinterpret_cast<PyObject*>(stamps);
+}
+
+static PyObject* converterToMET(Converter* self, PyObject* args, PyObject* kwargs) {
+	PyObject* obj;
+	ParallelOptions opts;
+	Input instants;
+	if (!parseArgs(self, args, kwargs, "instants", obj, opts) || !instants.get(obj, '\0', "instants")) return nullptr;
+
+	const Py_ssize_t n = instants.size();
+	Array* METs = newArray(n, sizeof(double), FLOAT64_FORMAT);
+	if (!METs) return nullptr;
+
+	// as TimeColumnReader::readMETs()
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(self->conv->missionStart(startFracSec));
+	const smart_instant* in = static_cast<const smart_instant*>(instants.data());
+	double* out = reinterpret_cast<double*>(METs->data);
+	convertAll(n, opts, "", [&](const size_t begin, const size_t count) {
+		for (size_t i = begin; i < begin + count; ++i) {
+			out[i] = static_cast<double>(in[i].sinceEpoch - startEpoch) + (in[i].fracSec() - startFracSec);
+		}
+		return true;
+	});
+	return reinterpret_cast<PyObject*>(METs);
+}
+
+static PyMethodDef converterMethods[] = {
+	{ "to_utc", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(converterToUTC)), METH_VARARGS | METH_KEYWORDS,
+		"to_utc(METs, threads=0)\n--\n\n"
+		"UTC of float64 METs, as a tuple of arrays (year, month, day, hour, minute, second: int64; frac: float64)" },
+	{ "to_datetime64", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(converterToDatetime64)), METH_VARARGS | METH_KEYWORDS,
+		"to_datetime64(METs, threads=0)\n--\n\n"
+		"UTC of float64 METs as int64 nanoseconds since 1970, i.e. datetime64[ns]; a leap second becomes the next second" },
+	{ "to_instants", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(converterToInstants)), METH_VARARGS | METH_KEYWORDS,
+		"to_instants(METs, threads=0)\n--\n\n"
+		"float64 METs as an array of smart_instants, [('since_epoch', '<i8'), ('frac', '<u8')]" },
+	{ "to_met", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(converterToMET)), METH_VARARGS | METH_KEYWORDS,
+		"to_met(instants, threads=0)\n--\n\n"
+		"float64 METs of an array of smart_instants" },
+	{ nullptr, nullptr, 0, nullptr }
+};
+
+static PyTypeObject ConverterType = {};
+
+// Module functions
+
+static PyObject* moduleInit(PyObject*, PyObject* args, PyObject* kwargs) {
+	static const char* keywords[] = { "epoch_year", "leap_file", nullptr };
+	long long epochYr;
+	const char* leapFile = nullptr;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "L|z", const_cast<char**>(keywords), &epochYr, &leapFile)) return nullptr;
+
+	// as smart_tm::init(), but failing loudly if the file cannot be opened
+	const std::shared_ptr<const TimeContext> context = leapFile ? TimeContext::create(epochYr, leapFile) : TimeContext::create(epochYr);
+	if (!context) {
+		PyErr_Format(PyExc_OSError, "cannot open leap second file '%s'", leapFile);
+		return nullptr;
+	}
+	TimeContext::setDefault(context);
+	Py_RETURN_NONE;
+}
+
+static PyObject* moduleEpochYear(PyObject*, PyObject*) {
+	return PyLong_FromLongLong(TimeContext::getDefault().epochYear());
+}
+
+static PyMethodDef moduleMethods[] = {
+	{ "init", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(moduleInit)), METH_VARARGS | METH_KEYWORDS,
+		"init(epoch_year, leap_file=None)\n--\n\n"
+		"Set the default epoch year and leap table (the built-in one if no file is given)"
+		" for Converters created afterwards" },
+	{ "epoch_year", moduleEpochYear, METH_NOARGS,
+		"epoch_year()\n--\n\n"
+		"Epoch year of the default context" },
+	{ nullptr, nullptr, 0, nullptr }
+};
+
+static PyModuleDef smarttimeModule = {
+	PyModuleDef_HEAD_INIT,
+	"smarttime",
+	"Whole-array MET <-> UTC conversion with the Smart Time System",
+	-1,
+	moduleMethods,
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+};
+
+PyMODINIT_FUNC PyInit_smarttime() {
+	// as PyVarObject_HEAD_INIT(nullptr, 0); PyType_Ready() sets the type
+	Py_SET_REFCNT(&ArrayType, 1);
+	Py_SET_REFCNT(&ConverterType, 1);
+
+	arraySequenceMethods.sq_length = reinterpret_cast<lenfunc>(arrayLength);
+
+	ArrayType.tp_name = "smarttime.Array";
+	ArrayType.tp_basicsize = sizeof(Array);
+	ArrayType.tp_dealloc = reinterpret_cast<destructor>(arrayDealloc);
+	ArrayType.tp_as_buffer = &arrayBufferProcs;
+	ArrayType.tp_as_sequence = &arraySequenceMethods;
+	ArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+	ArrayType.tp_doc = "Result array; wrap with numpy.asarray() (no copy) or memoryview()";
+
+	ConverterType.tp_name = "smarttime.Converter";
+	ConverterType.tp_basicsize = sizeof(Converter);
+	ConverterType.tp_dealloc = reinterpret_cast<destructor>(converterDealloc);
+	ConverterType.tp_flags = Py_TPFLAGS_DEFAULT;
+	ConverterType.tp_doc = "Converter(year, month, day, hour=0, minute=0, second=0, frac=0.0)\n--\n\n"
+		"MET conversions for a mission starting (MET 0) at the given UTC time, in the default context";
+	ConverterType.tp_methods = converterMethods;
+	ConverterType.tp_init = reinterpret_cast<initproc>(converterInit);
+	ConverterType.tp_new = PyType_GenericNew;
+
+	if (PyType_Ready(&ArrayType) < 0 || PyType_Ready(&ConverterType) < 0) return nullptr;
+
+	PyObject* module = PyModule_Create(&smarttimeModule);
+	if (!module) return nullptr;
+
+	Py_INCREF(&ConverterType);
+	Py_INCREF(&ArrayType);
+	if (PyModule_AddObject(module, "Converter", reinterpret_cast<PyObject*>(&ConverterType)) < 0 ||
+		PyModule_AddObject(module, "Array", reinterpret_cast<PyObject*>(&ArrayType)) < 0) {
+		Py_DECREF(module);
+		return nullptr;
+	}
+	return module;
+}
@@ -0,0 +1,489 @@
+/*******************************************************************
+*   SmartTimeValidate.cpp
+*	Exhaustive parallel validation against a field-stepping reference
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Checks every single second of a year range (by default 1900-2100,
+// about 6.3 billion seconds) through each fast path against a
+// reference that shares no code with them: calendar fields stepped
+// forward one second at a time by plain carrying, second by second,
+// minute by minute and so on up to years, with a second '60' wherever
+// the leap table's raw epoch list has a leap second. It is seeded at
+// the start of each shard by counting whole years and months from
+// epoch. adjust() is itself one of the fast paths checked.
+//
+// For each second, with a fractional second that varies from second
+// to second, the checks are:
+//	smart_tm(sinceEpoch)	the constant-time constructor
+//	adjust					the previous second, plus 1 s, adjusted
+//	toEpoch					back to the same second and fraction
+//	toMET / toUTC			TimeConverter single-value calls, with both
+//							(whole, fraction) and double METs
+//	toUTC batch				the batch calls, in blocks: double METs into
+//							smart_tms and into UTCColumns (both through
+//							the vectorized kernel where the CPU has it),
+//							and (whole, fraction) METs
+//	UTCCursor				the incremental converter, second by second
+//	format / parse			format() read back by parse()
+//	parseFixedWidth			the same text as fixed-width records
+// The fractions are multiples of 1/1024, so every check is exact.
+//
+// The range is split into one-day shards spread across all cores
+// with a ThreadPool (see ParallelConvert.h). The first mismatches
+// found, in time order, are printed with their expected and produced
+// values; the exit status is 1 if there are any.
+//
+// Build, for example:
+/*
+
+g++ -O3 -march=native -std=c++17 -pthread -o SmartTimeValidate SmartTimeValidate.cpp smart_tm.cpp TimeContext.cpp UTC_MET.cpp CivilSIMD.cpp ParallelConvert.cpp FileIO.cpp
+
+*/
+//
+// Example use:
+/*
+
+SmartTimeValidate
+SmartTimeValidate -e 1990 -y 1990-2030 -L 2008-06-11T16:05:00 -l leap-seconds.list
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ParallelConvert.h"
+#include "UTC_MET.h"
+#include "smart_tm.h"
+
+// seconds per shard, and per block within a shard for the batch checks
+#define SHARD_SECONDS				(SECONDS_PER_DAY)
+#define BLOCK_SECONDS				(1024)
+
+// fixed-width record size for parseFixedWidth(), padded with spaces
+#define RECORD_STRIDE				(40)
+
+// fractions are multiples of 1/FRAC_STEPS, exact in binary and in decimal text
+#define FRAC_STEPS					(1024)
+
+// UTCColumns fields other than fracSec
+#define TIME_FIELD_COLUMNS			(6)
+
+#define DEFAULT_SHOWN				(10)
+
+#define EXIT_MISMATCH				(1)
+#define EXIT_USAGE					(2)
+
+struct Options {
+	long long epochYr;
+	std::string leapFile;
+	long long fromYr;
+	long long toYr;
+	std::string launch;
+	size_t threads;
+	size_t shown;
+};
+
+struct Mismatch {
+	size_t sinceEpoch;
+	std::string check;
+	std::string expected;
+	std::string got;
+};
+
+// Keeps the earliest 'shown' mismatches found by any thread, and counts all of them
+class Mismatches {
+public:
+	explicit Mismatches(const size_t shown) : shown(shown), total(0) {}
+
+	void add(const size_t sinceEpoch, const char* check, const std::string& expected, const std::string& got) {
+		std::lock_guard<std::mutex> guard(lock);
+		++total;
+		if (first.size() == shown && !(sinceEpoch < first.back().sinceEpoch)) return;
+
+		Mismatch mismatch;
+		mismatch.sinceEpoch = sinceEpoch;
+		mismatch.check = check;
+		mismatch.expected = expected;
+		mismatch.got = got;
+		first.insert(std::upper_bound(first.begin(), first.end(), mismatch,
+			[](const Mismatch& lhs, const Mismatch& rhs) { return lhs.sinceEpoch < rhs.sinceEpoch; }), mismatch);
+		if (first.size() > shown) first.pop_back();
+	}
+
+	size_t count() const { return total; }
+	const std::vector<Mismatch>& earliest() const { return first; }
+
+private:
+	std::mutex lock;
+	const size_t shown;
+	size_t total;
+	std::vector<Mismatch> first;
+};
+
+static void usage(const char* name) {
+	std::cerr << "Usage: " << name << " [options]" << std::endl
+		<< "  -e YEAR      epoch year (default " << DEFAULT_EPOCH_YEAR << ")" << std::endl
+		<< "  -l FILE      leap second file (default: built-in table)" << std::endl
+		<< "  -y FROM-TO   years to check, from Jan 1 of FROM to Jan 1 of TO (default 1900-2100)" << std::endl
+		<< "  -L LAUNCH    mission start for the TimeConverter checks (default Jan 1 of FROM)" << std::endl
+		<< "  -t N         threads (default: all cores)" << std::endl
+		<< "  -k N         mismatches to show (default " << DEFAULT_SHOWN << ")" << std::endl;
+}
+
+static bool parseOptions(const int argc, char* argv[], Options& opts) {
+	opts.epochYr = DEFAULT_EPOCH_YEAR;
+	opts.fromYr = 1900;
+	opts.toYr = 2100;
+	opts.threads = 0;
+	opts.shown = DEFAULT_SHOWN;
+
+	for (int i = 1; i < argc; i += 2) {
+		const std::string flag = argv[i];
+		if (i + 1 >= argc || flag.size() != 2 || flag[0] != '-') return false;
+
+		const char* value = argv[i + 1];
+		char* end;
+		switch (flag[1]) {
+		case 'e': opts.epochYr = strtoll(value, nullptr, BASE_10_PLEASE); break;
+		case 'l': opts.leapFile = value; break;
+		case 'y':
+			opts.fromYr = strtoll(value, &end, BASE_10_PLEASE);
+			if (end == value || *end != '-') return false;
+			opts.toYr = strtoll(end + 1, nullptr, BASE_10_PLEASE);
+			break;
+		case 'L': opts.launch = value; break;
+		case 't': opts.threads = strtoull(value, nullptr, BASE_10_PLEASE); break;
+		case 'k': opts.shown = strtoull(value, nullptr, BASE_10_PLEASE); break;
+		default: return false;
+		}
+	}
+	return opts.fromYr >= opts.epochYr && opts.toYr > opts.fromYr && opts.toYr <= END_YR;
+}
+
+static double fracFor(const size_t sinceEpoch) {
+	return static_cast<double>(sinceEpoch % FRAC_STEPS) / FRAC_STEPS;
+}
+
+// Calendar fields of consecutive seconds since epoch, worked out with
+// nothing but the Gregorian calendar rules and the context's list of
+// leap second epochs, so independent of every smart_tm conversion
+class ReferenceClock {
+public:
+	// Start at the second sinceEpoch
+	ReferenceClock(const TimeContext& context, const size_t sinceEpoch)
+		: leapSeconds(context.leapSecondEpochs()), time(context.epochYear(), START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC) {
+		// leap seconds before this one, and whether it is one itself
+		nextLeap = std::lower_bound(leapSeconds.begin(), leapSeconds.end(), sinceEpoch) - leapSeconds.begin();
+		const bool inLeapSecond = nextLeap < leapSeconds.size() && leapSeconds[nextLeap] == sinceEpoch;
+
+		// ...leaving the nonleap seconds since epoch, for a leap
+		// second those of the 59th second before it
+		long long nonleap = static_cast<long long>(sinceEpoch - nextLeap) - (inLeapSecond ? 1 : 0);
+		while (nonleap >= daysInYear(time.yr) * SECONDS_PER_DAY) {
+			nonleap -= daysInYear(time.yr) * SECONDS_PER_DAY;
+			++time.yr;
+		}
+		while (nonleap >= daysInMonth(time.yr, time.mon) * SECONDS_PER_DAY) {
+			nonleap -= daysInMonth(time.yr, time.mon) * SECONDS_PER_DAY;
+			++time.mon;
+		}
+		time.day += nonleap / SECONDS_PER_DAY;
+		nonleap %= SECONDS_PER_DAY;
+		time.hr += nonleap / SECONDS_PER_HOUR;
+		nonleap %= SECONDS_PER_HOUR;
+		time.min += nonleap / TYPICAL_SECONDS_PER_MINUTE;
+		time.sec += nonleap % TYPICAL_SECONDS_PER_MINUTE;
+
+		if (inLeapSecond) {
+			++time.sec;
+			++nextLeap;
+		}
+		current = sinceEpoch;
+	}
+
+	const smart_tm& fields() const { return time; }
+
+	// Move on to the next second
+	void step() {
+		++current;
+		if (nextLeap < leapSeconds.size() && leapSeconds[nextLeap] == current) {
+			// second '60' follows second 59
+			++time.sec;
+			++nextLeap;
+			return;
+		}
+
+		if (++time.sec < START_SEC + TYPICAL_SECONDS_PER_MINUTE) return;
+		time.sec = START_SEC;
+		if (++time.min < START_MIN + MINUTES_PER_HOUR) return;
+		time.min = START_MIN;
+		if (++time.hr < START_HR + HOURS_PER_DAY) return;
+		time.hr = START_HR;
+		if (++time.day < START_DAY + daysInMonth(time.yr, time.mon)) return;
+		time.day = START_DAY;
+		if (++time.mon < START_MON + MONTHS_PER_YEAR) return;
+		time.mon = START_MON;
+		++time.yr;
+	}
+
+private:
+	static bool isLeapYear(const long long yr) {
+		return (yr % 4 == 0) && ((yr % 400 == 0) || (yr % 100 != 0));
+	}
+
+	static long long daysInYear(const long long yr) {
+		return isLeapYear(yr) ? TYPICAL_DAYS_PER_YEAR + 1 : TYPICAL_DAYS_PER_YEAR;
+	}
+
+	static long long daysInMonth(const long long yr, const long long mon) {
+		static const long long days[MONTHS_PER_YEAR] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+		return (mon - START_MON == smart_tm::Feb && isLeapYear(yr)) ? days[smart_tm::Feb] + 1 : days[mon - START_MON];
+	}
+
+	const std::vector<size_t>& leapSeconds;
+	smart_tm time;
+	size_t current;
+
+	// index of the first leap second after current
+	size_t nextLeap;
+};
+
+// Everything one shard needs, reused from shard to shard by a thread
+struct Scratch {
+	std::vector<smart_tm> refs;
+	std::vector<size_t> wholeMETs;
+	std::vector<double> fracMETs;
+	std::vector<double> METs;
+	std::vector<smart_tm> batch;
+	std::vector<long long> columns[TIME_FIELD_COLUMNS];
+	std::vector<double> fracColumn;
+	std::vector<char> records;
+	std::vector<smart_tm> parsed;
+};
+
+class Validator {
+public:
+	Validator(const std::shared_ptr<const TimeContext>& context, const TimeConverter& conv, const size_t launchEpoch, Mismatches& mismatches)
+		: context(context), conv(conv), launchEpoch(launchEpoch), mismatches(mismatches) {}
+
+	// Check every second in [first, last)
+	void run(const size_t first, const size_t last, Scratch& scratch) const {
+		const TimeContext& ctx = *context;
+
+		// the reference, seeded once per shard...
+		ReferenceClock clock(ctx, first);
+		smart_tm ref = clock.fields();
+		smart_tm previous = ref;
+
+		UTCCursor cursor(conv);
+
+		for (size_t blockStart = first; blockStart < last; blockStart += BLOCK_SECONDS) {
+			const size_t n = std::min(static_cast<size_t>(BLOCK_SECONDS), last - blockStart);
+			scratch.refs.resize(n);
+			scratch.wholeMETs.clear();
+			scratch.fracMETs.clear();
+			scratch.METs.clear();
+			scratch.records.assign(n * RECORD_STRIDE, ' ');
+
+			for (size_t i = 0; i < n; ++i) {
+				const size_t sinceEpoch = blockStart + i;
+				const double frac = fracFor(sinceEpoch);
+
+				// ...and stepped one second at a time, checking adjust()
+				// with the same step from the previous second
+				if (sinceEpoch != first) {
+					clock.step();
+					ref = clock.fields();
+
+					smart_tm adjusted = previous;
+					adjusted.fracSec = START_FRAC_SEC;
+					++adjusted.sec;
+					adjusted.adjust(ctx);
+					if (!adjusted.equalsWithFrac(ref)) report(sinceEpoch, "adjust", ref, adjusted);
+				}
+				previous = ref;
+				ref.fracSec = frac;
+				scratch.refs[i] = ref;
+
+				checkScalar(sinceEpoch, frac, ref, cursor);
+
+				char* record = &scratch.records[i * RECORD_STRIDE];
+				ref.format(record, RECORD_STRIDE);
+				// format() null-terminates; the record must not be
+				std::replace(record, record + RECORD_STRIDE, '\0', ' ');
+
+				if (sinceEpoch >= launchEpoch) {
+					scratch.wholeMETs.push_back(sinceEpoch - launchEpoch);
+					scratch.fracMETs.push_back(frac);
+					scratch.METs.push_back(static_cast<double>(sinceEpoch - launchEpoch) + frac);
+				}
+			}
+
+			checkBatch(blockStart, n, scratch);
+		}
+	}
+
+private:
+	void report(const size_t sinceEpoch, const char* check, const smart_tm& expected, const smart_tm& got) const {
+		mismatches.add(sinceEpoch, check, expected.toString(), got.toString());
+	}
+
+	void checkScalar(const size_t sinceEpoch, const double frac, const smart_tm& ref, UTCCursor& cursor) const {
+		const TimeContext& ctx = *context;
+
+		const smart_tm constructed(sinceEpoch, frac, ctx);
+		if (!constructed.equalsWithFrac(ref)) report(sinceEpoch, "smart_tm(sinceEpoch)", ref, constructed);
+
+		double fracOut;
+		const size_t epochOut = ref.toEpoch(fracOut, ctx);
+		if (epochOut != sinceEpoch || fracOut != frac) {
+			mismatches.add(sinceEpoch, "toEpoch", std::to_string(sinceEpoch) + " + " + std::to_string(frac), std::to_string(epochOut) + " + " + std::to_string(fracOut));
+		}
+
+		if (sinceEpoch >= launchEpoch) {
+			const size_t MET = sinceEpoch - launchEpoch;
+
+			const size_t METOut = conv.toMET(ref, fracOut);
+			if (METOut != MET || fracOut != frac) {
+				mismatches.add(sinceEpoch, "toMET", std::to_string(MET) + " + " + std::to_string(frac), std::to_string(METOut) + " + " + std::to_string(fracOut));
+			}
+
+			const smart_tm fromPair = conv.toUTC(MET, frac);
+			if (!fromPair.equalsWithFrac(ref)) report(sinceEpoch, "toUTC(whole, frac)", ref, fromPair);
+
+			const smart_tm fromDouble = conv.toUTC(static_cast<double>(MET) + frac);
+			if (!fromDouble.equalsWithFrac(ref)) report(sinceEpoch, "toUTC(double)", ref, fromDouble);
+
+			const smart_tm& fromCursor = cursor.toUTC(MET, frac);
+			if (!fromCursor.equalsWithFrac(ref)) report(sinceEpoch, "UTCCursor", ref, fromCursor);
+		}
+
+		char text[FORMAT_BUFFER_SIZE];
+		const size_t length = ref.format(text, sizeof(text));
+		smart_tm parsed(ctx);
+		if (smart_tm::parse(text, text + length, parsed, ctx) != text + length || !parsed.equalsWithFrac(ref)) {
+			mismatches.add(sinceEpoch, "format / parse", ref.toString(), std::string(text, length) + " -> " + parsed.toString());
+		}
+	}
+
+	void checkBatch(const size_t blockStart, const size_t n, Scratch& scratch) const {
+		const TimeContext& ctx = *context;
+
+		// METs start at the first second at or after launch
+		const size_t METs = scratch.wholeMETs.size();
+		const size_t offset = n - METs;
+		const smart_tm* refs = scratch.refs.data() + offset;
+		scratch.batch.resize(METs);
+
+		conv.toUTC(scratch.wholeMETs.data(), scratch.fracMETs.data(), METs, scratch.batch.data());
+		for (size_t i = 0; i < METs; ++i) {
+			if (!scratch.batch[i].equalsWithFrac(refs[i])) report(blockStart + offset + i, "toUTC batch (whole, frac)", refs[i], scratch.batch[i]);
+		}
+
+		conv.toUTC(scratch.METs.data(), METs, scratch.batch.data());
+		for (size_t i = 0; i < METs; ++i) {
+			if (!scratch.batch[i].equalsWithFrac(refs[i])) report(blockStart + offset + i, "toUTC batch (double)", refs[i], scratch.batch[i]);
+		}
+
+		for (std::vector<long long>& column : scratch.columns) column.resize(METs);
+		scratch.fracColumn.resize(METs);
+		const UTCColumns columns = {
+			scratch.columns[0].data(), scratch.columns[1].data(), scratch.columns[2].data(),
+			scratch.columns[3].data(), scratch.columns[4].data(), scratch.columns[5].data(),
+			scratch.fracColumn.data()
+		};
+		conv.toUTC(scratch.METs.data(), METs, columns);
+		for (size_t i = 0; i < METs; ++i) {
+			const smart_tm fromColumns(columns.yr[i], columns.mon[i], columns.day[i], columns.hr[i], columns.min[i], columns.sec[i], columns.fracSec[i]);
+			if (!fromColumns.equalsWithFrac(refs[i])) report(blockStart + offset + i, "toUTC batch (columns)", refs[i], fromColumns);
+		}
+
+		scratch.parsed.resize(n);
+		const size_t parsedCount = smart_tm::parseFixedWidth(scratch.records.data(), RECORD_STRIDE, n, scratch.parsed.data(), ctx);
+		for (size_t i = 0; i < n; ++i) {
+			if (i >= parsedCount) {
+				mismatches.add(blockStart + i, "parseFixedWidth", scratch.refs[i].toString(), "parse failure");
+				break;
+			}
+			if (!scratch.parsed[i].equalsWithFrac(scratch.refs[i])) report(blockStart + i, "parseFixedWidth", scratch.refs[i], scratch.parsed[i]);
+		}
+	}
+
+	std::shared_ptr<const TimeContext> context;
+	const TimeConverter& conv;
+	const size_t launchEpoch;
+	Mismatches& mismatches;
+};
+
+int main(int argc, char* argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		usage(argv[0]);
+		return EXIT_USAGE;
+	}
+
+	const std::shared_ptr<const TimeContext> context = opts.leapFile.empty() ? TimeContext::create(opts.epochYr) : TimeContext::create(opts.epochYr, opts.leapFile);
+	if (!context) return EXIT_USAGE;
+
+	const smart_tm fromTM(opts.fromYr, START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC);
+	const smart_tm toTM(opts.toYr, START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC);
+	const size_t first = fromTM.toEpoch(*context);
+	const size_t last = toTM.toEpoch(*context);
+
+	smart_tm launch = fromTM;
+	if (!opts.launch.empty() && !smart_tm::parse(opts.launch, launch, *context)) {
+		std::cerr << "ERROR: Invalid launch time " << opts.launch << '.' << std::endl;
+		return EXIT_USAGE;
+	}
+	if (launch.fracSec != START_FRAC_SEC) {
+		std::cerr << "ERROR: Launch time must be a whole second." << std::endl;
+		return EXIT_USAGE;
+	}
+	const TimeConverter conv(launch, context);
+
+	Mismatches mismatches(opts.shown);
+	const Validator validator(context, conv, launch.toEpoch(*context), mismatches);
+
+	ThreadPool pool(opts.threads);
+	const size_t shards = (last - first + SHARD_SECONDS - 1) / SHARD_SECONDS;
+	std::atomic<size_t> shardsDone(0);
+
+	std::cerr << "Checking " << (last - first) << " seconds from " << fromTM << " to " << toTM
+		<< " on " << pool.size() << " threads..." << std::endl;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	pool.run(shards, [&](const size_t shard) {
+		thread_local Scratch scratch;
+		const size_t shardStart = first + shard * SHARD_SECONDS;
+		validator.run(shardStart, std::min(shardStart + SHARD_SECONDS, last), scratch);
+
+		// progress in whole percent, from whichever thread crosses each step
+		const size_t done = shardsDone.fetch_add(1, std::memory_order_relaxed) + 1;
+		if (done * 100 / shards != (done - 1) * 100 / shards) {
+			fprintf(stderr, "\r%3zu%%", done * 100 / shards);
+			fflush(stderr);
+		}
+	});
+
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	fprintf(stderr, "\n");
+
+	for (const Mismatch& mismatch : mismatches.earliest()) {
+		std::cout << "MISMATCH at " << mismatch.sinceEpoch << " in " << mismatch.check << ": expected " << mismatch.expected << ", got " << mismatch.got << std::endl;
+	}
+	std::cout << (last - first) << " seconds checked in " << elapsed << " s; " << mismatches.count() << " mismatches" << std::endl;
+
+	return mismatches.count() ? EXIT_MISMATCH : EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*******************************************************************
+*   TimeBinner.cpp
+*	Leap-aware binning of times by UTC second, minute, hour or day
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include <algorithm>
+
+#include "TimeBinner.h"
+
+// nonleap seconds per unit; Second bins count leap seconds too
+static const long long unitSeconds[TimeBinner::UnitCount] = { 1, TYPICAL_SECONDS_PER_MINUTE, SECONDS_PER_HOUR, SECONDS_PER_DAY };
+
+TimeBinner::TimeBinner(const Unit unit, const long long width /* =1 */, const long long originEpoch /* =0 */,
+	const std::shared_ptr<const TimeContext>& context /* =TimeContext::sharedDefault() */)
+	: context(context), which(unit), binWidth(std::max(width, 1LL)), span(unitSeconds[unit] * binWidth), origin(originEpoch) {
+	context->checkInit();
+
+	if (which != Second) {
+		size_t leapHint = 0;
+		origin = floorDiv(nonleapSince(originEpoch, leapHint), unitSeconds[unit]) * unitSeconds[unit];
+	}
+}
+
+long long TimeBinner::nonleapSince(const long long sinceEpoch, size_t& leapHint) const {
+	// leap seconds at or before sinceEpoch, usually found at or next to
+	// the hint; for any time after the last leap second, all of them
+	const std::vector<size_t>& deltas = context->leapSecondEpochs();
+	const size_t n = deltas.size();
+	if (n == 0 || static_cast<long long>(deltas.back()) <= sinceEpoch) {
+		leapHint = n;
+	}
+	else if (leapHint > n || (leapHint > 0 && static_cast<long long>(deltas[leapHint - 1]) > sinceEpoch) ||
+		(leapHint < n && static_cast<long long>(deltas[leapHint]) <= sinceEpoch)) {
+		leapHint = std::upper_bound(deltas.begin(), deltas.end(), sinceEpoch,
+			[](const long long time, const size_t leapSecond) { return time < static_cast<long long>(leapSecond); }) - deltas.begin();
+	}
+	return sinceEpoch - static_cast<long long>(leapHint);
+}
+
+long long TimeBinner::epochOfMinute(const long long nonleap) const {
+	// every leap second whose following minute starts at or before
+	// nonleap has been walked through (see smart_clock::fromUnixSeconds())
+	const std::vector<size_t>& deltas = context->leapSecondEpochs();
+	const long long n = static_cast<long long>(deltas.size());
+	const auto walkedThrough = [&](const long long i) { return static_cast<long long>(deltas[i]) - i <= nonleap; };
+	if (n == 0 || walkedThrough(n - 1)) return nonleap + n;
+
+	long long lo = 0, hi = n - 1;
+	while (lo < hi) {
+		const long long mid = lo + (hi - lo) / 2;
+		if (walkedThrough(mid)) lo = mid + 1;
+		else hi = mid;
+	}
+	return nonleap + lo;
+}
+
+long long TimeBinner::bin(const long long sinceEpoch, size_t& leapHint) const {
+	if (which == Second) return floorDiv(sinceEpoch - origin, span);
+	return floorDiv(nonleapSince(sinceEpoch, leapHint) - origin, span);
+}
+
+long long TimeBinner::bin(const long long sinceEpoch) const {
+	size_t leapHint = 0;
+	return bin(sinceEpoch, leapHint);
+}
+
+long long TimeBinner::binStart(const long long bin) const {
+	if (which == Second) return origin + bin * span;
+	return epochOfMinute(origin + bin * span);
+}
+
+long long TimeBinner::floor(const long long sinceEpoch) const {
+	return binStart(bin(sinceEpoch));
+}
+
+long long TimeBinner::ceil(const long long sinceEpoch) const {
+	const long long containing = bin(sinceEpoch);
+	const long long start = binStart(containing);
+	return start == sinceEpoch ? start : binStart(containing + 1);
+}
+
+void TimeBinner::bins(const long long* epochs, const size_t n, long long* binsOut) const {
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) binsOut[i] = bin(epochs[i], leapHint);
+}
+
+void TimeBinner::bins(const smart_instant* times, const size_t n, long long* binsOut) const {
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) binsOut[i] = bin(times[i].sinceEpoch, leapHint);
+}
+
+void TimeBinner::bins(const TimeConverter& conv, const double* METs, const size_t n, long long* binsOut) const {
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		// whole seconds of the time, as toUTC() has them
+		const double wholeMET = std::floor(METs[i]);
+		const long long sinceEpoch = startEpoch + static_cast<long long>(wholeMET) + static_cast<long long>(std::floor(startFracSec + (METs[i] - wholeMET)));
+		binsOut[i] = bin(sinceEpoch, leapHint);
+	}
+}
+
+void TimeBinner::bins(const TimeConverter& conv, const size_t* wholeMETs, const double* fracMETs, const size_t n, long long* binsOut) const {
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		const long long sinceEpoch = startEpoch + static_cast<long long>(wholeMETs[i]) + static_cast<long long>(std::floor(startFracSec + fracMETs[i]));
+		binsOut[i] = bin(sinceEpoch, leapHint);
+	}
+}
@@ -0,0 +1,115 @@
+/*******************************************************************
+*   TimeBinner.h
+*	Leap-aware binning of times by UTC second, minute, hour or day
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Bins leap-aware seconds since epoch (as from toEpoch(), smart_instant
+// or a TimeConverter's METs) into UTC seconds, minutes, hours or days,
+// or runs of 'width' of them, counted from an origin, e.g. for daily
+// light curves or per-minute event counts, without ever producing
+// calendar fields.
+//
+// Minutes, hours and days are calendar units: a bin ending in a leap
+// second is one second longer, and the leap second itself falls in it,
+// as 23:59:60 does in smart_tm. Seconds are SI seconds, so a leap second
+// is a second bin of its own. Either way, a bin index is one leap table
+// lookup (carried from each element to the next in the batch calls,
+// so sorted input rarely searches at all) and one division.
+//
+// Times with fractional seconds lie within their whole second, so bin
+// and floor with the whole seconds; ceil() of a time with a nonzero
+// fraction is ceil() of the whole second after it.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+TimeConverter conv(smart_tm(2008, 6, 11, 16, 5, 0, 0.0));
+
+// whole UTC days, from the day of launch
+double fracSec;
+const TimeBinner days(TimeBinner::Day, 1, static_cast<long long>(conv.missionStart(fracSec)));
+
+std::vector<long long> bins(METs.size());
+days.bins(conv, METs.data(), METs.size(), bins.data());
+for (const long long bin : bins) ++counts[bin];
+
+// first second of each day
+const smart_tm dayStart(static_cast<size_t>(days.binStart(bins.front())));
+
+*/
+
+#ifndef TIME_BINNER_H
+#define TIME_BINNER_H
+
+#include "UTC_MET.h"
+#include "smart_instant.h"
+#include "smart_tm.h"
+
+class TimeBinner {
+public:
+	enum Unit {
+		Second,
+		Minute,
+		Hour,
+		Day,
+		UnitCount
+	};
+
+	// Bins of width units each (a width below 1 is taken as 1), the first
+	// (bin 0) starting at the start of the unit containing originEpoch;
+	// by default, epoch.
+	// Uses the given context, held for the lifetime of the binner (which
+	// must not be null); by default, the default context at construction.
+	explicit TimeBinner(const Unit unit, const long long width = 1, const long long originEpoch = 0,
+		const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault());
+
+	Unit unit() const { return which; }
+	long long width() const { return binWidth; }
+
+	// Index of the bin containing a time; negative before the origin
+	long long bin(const long long sinceEpoch) const;
+
+	// First second (leap-aware, since epoch) of a bin
+	long long binStart(const long long bin) const;
+
+	// First second of the bin containing a time, and the first bin
+	// boundary at or after it
+	long long floor(const long long sinceEpoch) const;
+	long long ceil(const long long sinceEpoch) const;
+
+	// Batch bin() of n values at a time, matching bin() element for
+	// element. Times given as METs are those of conv's mission, whose
+	// context must be this one's.
+	void bins(const long long* epochs, const size_t n, long long* binsOut) const;
+	void bins(const smart_instant* times, const size_t n, long long* binsOut) const;
+	void bins(const TimeConverter& conv, const double* METs, const size_t n, long long* binsOut) const;
+	void bins(const TimeConverter& conv, const size_t* wholeMETs, const double* fracMETs, const size_t n, long long* binsOut) const;
+
+private:
+	// bin() with the position in the leap table carried in leapHint
+	long long bin(const long long sinceEpoch, size_t& leapHint) const;
+
+	// seconds since epoch ignoring leap seconds, a leap second
+	// reading as the second before it (59), and the reverse
+	// for a time on a minute boundary
+	long long nonleapSince(const long long sinceEpoch, size_t& leapHint) const;
+	long long epochOfMinute(const long long nonleap) const;
+
+	std::shared_ptr<const TimeContext> context;
+	Unit which;
+	long long binWidth;
+
+	// seconds per bin; for Second, leap-aware, otherwise nonleap
+	long long span;
+
+	// bin 0's first second, leap-aware or (for all but Second) nonleap
+	long long origin;
+};
+
+#endif
@@ -0,0 +1,296 @@
+/*******************************************************************
+*   TimeColumn.cpp
+*	Compact binary columns of timestamps
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include "TimeColumn.h"
+
+// FNV-1a
+#define FINGERPRINT_BASIS			(14695981039346656037ULL)
+#define FINGERPRINT_PRIME			(1099511628211ULL)
+
+// varint payload bits per byte, and the continuation bit
+#define VARINT_BITS					(7)
+#define VARINT_MORE					(0x80)
+#define VARINT_MAX_BYTES			(10)
+
+// fixed-point values hold seconds from the block base in the bits above
+// the fraction, kept below 2^62 in magnitude so that differences fit too
+#define VALUE_SECOND_BITS(fracBits)	(62 - (fracBits))
+
+static void putLE(std::vector<uint8_t>& out, uint64_t value, const size_t bytes) {
+	for (size_t i = 0; i < bytes; ++i, value >>= 8) out.push_back(static_cast<uint8_t>(value));
+}
+
+static uint64_t getLE(const uint8_t* in, const size_t bytes) {
+	uint64_t value = 0;
+	for (size_t i = bytes; i-- > 0; ) value = (value << 8) | in[i];
+	return value;
+}
+
+static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+	while (value >= VARINT_MORE) {
+		out.push_back(static_cast<uint8_t>(value | VARINT_MORE));
+		value >>= VARINT_BITS;
+	}
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+// false if the varint runs past end or is too long
+static bool getVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+	value = 0;
+	for (unsigned shift = 0; in < end && shift < VARINT_MAX_BYTES * VARINT_BITS; shift += VARINT_BITS) {
+		const uint8_t byte = *in++;
+		value |= static_cast<uint64_t>(byte & (VARINT_MORE - 1)) << shift;
+		if (!(byte & VARINT_MORE)) return true;
+	}
+	return false;
+}
+
+// small differences of either sign to small unsigned codes, and back;
+// the differences are taken modulo 2^64, which decoding undoes exactly
+static uint64_t zigzag(const uint64_t delta) {
+	return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+static uint64_t unzigzag(const uint64_t code) {
+	return (code >> 1) ^ (0 - (code & 1));
+}
+
+uint64_t leapTableFingerprint(const TimeContext& context) {
+	uint64_t hash = FINGERPRINT_BASIS;
+	const auto mix = [&hash](uint64_t value) {
+		for (size_t i = 0; i < sizeof(value); ++i, value >>= 8) hash = (hash ^ (value & 0xFF)) * FINGERPRINT_PRIME;
+	};
+	mix(context.leapSecondsBeforeEpoch());
+	for (const size_t leapSecond : context.leapSecondEpochs()) mix(leapSecond);
+	return hash;
+}
+
+TimeColumnWriter::TimeColumnWriter(const std::string& path, const std::shared_ptr<const TimeContext>& context /* =TimeContext::sharedDefault() */,
+	const size_t blockSize /* =DEFAULT_COLUMN_BLOCK_SIZE */, const unsigned fracBits /* =DEFAULT_COLUMN_FRAC_BITS */)
+	: file(path, std::ios::out | std::ios::binary | std::ios::trunc), context(context),
+	blockSize(std::min(std::max(blockSize, static_cast<size_t>(1)), static_cast<size_t>(UINT32_MAX))), fracBits(std::min(fracBits, static_cast<unsigned>(MAX_COLUMN_FRAC_BITS))),
+	closed(false), count(0), fileOffset(TIME_COLUMN_HEADER_SIZE), blockCount(0), inBlock(0), blockBase(0), prevValue(0), prevDelta(0) {
+
+	// header placeholder, filled in by close()
+	const char header[TIME_COLUMN_HEADER_SIZE] = {};
+	file.write(header, TIME_COLUMN_HEADER_SIZE);
+}
+
+TimeColumnWriter::~TimeColumnWriter() {
+	close();
+}
+
+void TimeColumnWriter::write(const smart_instant& time) {
+	// a new block at blockSize times, or if this time is too far from
+	// the block base for its fixed-point value, so any span of times works
+	// (the distance from the base taken unsigned, which cannot overflow)
+	const uint64_t span = 1ULL << VALUE_SECOND_BITS(fracBits);
+	const uint64_t distance = time.sinceEpoch >= blockBase ? static_cast<uint64_t>(time.sinceEpoch) - static_cast<uint64_t>(blockBase) :
+		static_cast<uint64_t>(blockBase) - static_cast<uint64_t>(time.sinceEpoch);
+	if (inBlock == blockSize || (inBlock && distance >= span)) endBlock();
+
+	if (inBlock == 0) {
+		putLE(index, fileOffset, sizeof(uint64_t));
+		putLE(index, count, sizeof(uint64_t));
+		putLE(index, static_cast<uint64_t>(time.sinceEpoch), sizeof(uint64_t));
+		blockBase = time.sinceEpoch;
+		prevValue = prevDelta = 0;
+	}
+
+	const uint64_t fraction = fracBits ? time.frac >> (64 - fracBits) : 0;
+	const uint64_t value = (static_cast<uint64_t>(time.sinceEpoch - blockBase) << fracBits) | fraction;
+	const uint64_t delta = value - prevValue;
+	putVarint(block, zigzag(delta - prevDelta));
+	prevValue = value;
+	prevDelta = delta;
+
+	++inBlock;
+	++count;
+}
+
+void TimeColumnWriter::write(const smart_instant* times, const size_t n) {
+	for (size_t i = 0; i < n; ++i) write(times[i]);
+}
+
+void TimeColumnWriter::write(const smart_tm* times, const size_t n) {
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) write(smart_instant(times[i], leapHint, *context));
+}
+
+void TimeColumnWriter::write(const TimeConverter& conv, const double* METs, const size_t n) {
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	for (size_t i = 0; i < n; ++i) {
+		const double wholeMET = floor(METs[i]);
+		write(smart_instant::fromEpoch(startEpoch + static_cast<long long>(wholeMET), startFracSec + (METs[i] - wholeMET)));
+	}
+}
+
+void TimeColumnWriter::write(const TimeConverter& conv, const size_t* wholeMETs, const double* fracMETs, const size_t n) {
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	for (size_t i = 0; i < n; ++i) {
+		write(smart_instant::fromEpoch(startEpoch + static_cast<long long>(wholeMETs[i]), startFracSec + fracMETs[i]));
+	}
+}
+
+void TimeColumnWriter::endBlock() {
+	if (!inBlock) return;
+	file.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+	fileOffset += block.size();
+	block.clear();
+	inBlock = 0;
+	++blockCount;
+}
+
+bool TimeColumnWriter::close() {
+	if (closed) return file.good();
+	closed = true;
+
+	endBlock();
+	const uint64_t indexOffset = fileOffset;
+	file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+
+	std::vector<uint8_t> header;
+	putLE(header, TIME_COLUMN_MAGIC, sizeof(uint32_t));
+	putLE(header, TIME_COLUMN_VERSION, sizeof(uint16_t));
+	putLE(header, fracBits, sizeof(uint8_t));
+	putLE(header, 0, sizeof(uint8_t));
+	putLE(header, static_cast<uint64_t>(context->epochYear()), sizeof(uint64_t));
+	putLE(header, leapTableFingerprint(*context), sizeof(uint64_t));
+	putLE(header, count, sizeof(uint64_t));
+	putLE(header, blockCount, sizeof(uint64_t));
+	putLE(header, indexOffset, sizeof(uint64_t));
+	putLE(header, blockSize, sizeof(uint32_t));
+	putLE(header, 0, sizeof(uint32_t));
+
+	file.seekp(0);
+	file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+	file.close();
+	return !file.fail();
+}
+
+TimeColumnReader::TimeColumnReader(const std::string& path)
+	: valid(false), epochYr(0), fingerprint(0), fracBits(0), count(0), indexOffset(0) {
+	if (!map.open(path, false) || map.size() < TIME_COLUMN_HEADER_SIZE) return;
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(map.data());
+
+	if (getLE(data, sizeof(uint32_t)) != TIME_COLUMN_MAGIC || getLE(data + 4, sizeof(uint16_t)) != TIME_COLUMN_VERSION) return;
+	fracBits = static_cast<unsigned>(data[6]);
+	epochYr = static_cast<long long>(getLE(data + 8, sizeof(uint64_t)));
+	fingerprint = getLE(data + 16, sizeof(uint64_t));
+	count = static_cast<size_t>(getLE(data + 24, sizeof(uint64_t)));
+	const uint64_t numBlocks = getLE(data + 32, sizeof(uint64_t));
+	indexOffset = getLE(data + 40, sizeof(uint64_t));
+	if (fracBits > MAX_COLUMN_FRAC_BITS || indexOffset < TIME_COLUMN_HEADER_SIZE || indexOffset > map.size() ||
+		numBlocks > (map.size() - indexOffset) / TIME_COLUMN_INDEX_ENTRY_SIZE || numBlocks > count) return;
+
+	// blocks must be in order, non-empty, and within the file
+	blocks.resize(static_cast<size_t>(numBlocks));
+	for (size_t i = 0; i < blocks.size(); ++i) {
+		const uint8_t* entry = data + indexOffset + i * TIME_COLUMN_INDEX_ENTRY_SIZE;
+		blocks[i].offset = getLE(entry, sizeof(uint64_t));
+		blocks[i].first = static_cast<size_t>(getLE(entry + 8, sizeof(uint64_t)));
+		blocks[i].base = static_cast<long long>(getLE(entry + 16, sizeof(uint64_t)));
+		if (blocks[i].offset > indexOffset || blocks[i].first >= count) return;
+		if (i == 0 ? (blocks[i].offset != TIME_COLUMN_HEADER_SIZE || blocks[i].first != 0) :
+			(blocks[i].offset <= blocks[i - 1].offset || blocks[i].first <= blocks[i - 1].first)) return;
+	}
+	valid = blocks.empty() == (count == 0);
+}
+
+bool TimeColumnReader::matches(const TimeContext& context) const {
+	return valid && context.epochYear() == epochYr && leapTableFingerprint(context) == fingerprint;
+}
+
+size_t TimeColumnReader::blockLength(const size_t block) const {
+	return (block + 1 < blocks.size() ? blocks[block + 1].first : count) - blocks[block].first;
+}
+
+template <typename Sink>
+bool TimeColumnReader::decode(const size_t first, const size_t n, Sink sink) const {
+	if (!valid || first > count || n > count - first) return false;
+	if (n == 0) return true;
+
+	const uint8_t* data = reinterpret_cast<const uint8_t*>(map.data());
+	const uint64_t fractionMask = (1ULL << fracBits) - 1;
+
+	// the block holding the first time
+	size_t b = static_cast<size_t>(std::upper_bound(blocks.begin(), blocks.end(), first,
+		[](const size_t pos, const Block& block) { return pos < block.first; }) - blocks.begin()) - 1;
+
+	size_t done = 0;
+	for (; done < n; ++b) {
+		const Block& block = blocks[b];
+		const uint8_t* in = data + block.offset;
+		const uint8_t* end = data + (b + 1 < blocks.size() ? blocks[b + 1].offset : indexOffset);
+
+		// every time in the block up to the range is decoded too, since each
+		// value builds on the last; the range then ends here or in a later block
+		const size_t length = blockLength(b);
+		const size_t skip = first + done - block.first;
+		const size_t stop = std::min(length, skip + (n - done));
+
+		uint64_t value = 0, delta = 0;
+		for (size_t i = 0; i < stop; ++i) {
+			uint64_t code;
+			if (!getVarint(in, end, code)) return false;
+			delta += unzigzag(code);
+			value += delta;
+			if (i >= skip) {
+				const uint64_t fraction = value & fractionMask;
+				sink(done++, smart_instant(block.base + (static_cast<long long>(value) >> fracBits), fracBits ? fraction << (64 - fracBits) : 0));
+			}
+		}
+	}
+	return true;
+}
+
+bool TimeColumnReader::read(const size_t first, const size_t n, smart_instant* timesOut) const {
+	return decode(first, n, [timesOut](const size_t i, const smart_instant& time) { timesOut[i] = time; });
+}
+
+bool TimeColumnReader::read(const size_t first, const size_t n, smart_tm* timesOut, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	size_t leapHint = 0;
+	return decode(first, n, [&](const size_t i, const smart_instant& time) {
+		timesOut[i] = smart_tm(static_cast<size_t>(time.sinceEpoch), time.fracSec(), leapHint, context);
+	});
+}
+
+bool TimeColumnReader::read(const size_t first, const size_t n, const UTCColumns& timesOut, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	size_t leapHint = 0;
+	return decode(first, n, [&](const size_t i, const smart_instant& time) {
+		const smart_tm tm(static_cast<size_t>(time.sinceEpoch), time.fracSec(), leapHint, context);
+		if (timesOut.yr) timesOut.yr[i] = tm.yr;
+		if (timesOut.mon) timesOut.mon[i] = tm.mon;
+		if (timesOut.day) timesOut.day[i] = tm.day;
+		if (timesOut.hr) timesOut.hr[i] = tm.hr;
+		if (timesOut.min) timesOut.min[i] = tm.min;
+		if (timesOut.sec) timesOut.sec[i] = tm.sec;
+		if (timesOut.fracSec) timesOut.fracSec[i] = tm.fracSec;
+	});
+}
+
+bool TimeColumnReader::readMETs(const TimeConverter& conv, const size_t first, const size_t n, double* METsOut) const {
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	return decode(first, n, [&](const size_t i, const smart_instant& time) {
+		METsOut[i] = static_cast<double>(time.sinceEpoch - startEpoch) + (time.fracSec() - startFracSec);
+	});
+}
+
+bool TimeColumnReader::readMETs(const TimeConverter& conv, const size_t first, const size_t n, size_t* wholeMETsOut, double* fracMETsOut) const {
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	return decode(first, n, [&](const size_t i, const smart_instant& time) {
+		wholeMETsOut[i] = static_cast<size_t>(time.sinceEpoch - startEpoch);
+		fracMETsOut[i] = time.fracSec() - startFracSec;
+	});
+}
@@ -0,0 +1,192 @@
+/*******************************************************************
+*   TimeColumn.h
+*	Compact binary columns of timestamps
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// A binary file format for long columns of timestamps, replacing
+// archives of toString() text (26+ bytes per time, and slow to parse).
+//
+// Times are stored as smart_instants, i.e. leap-aware seconds since
+// epoch plus a fraction, the latter kept to fracBits bits (by default
+// 32, about a quarter of a nanosecond). Each time becomes one 64-bit
+// fixed-point value relative to the first second of its block, and the
+// file stores the zigzag varint of each value's second difference
+// (delta of deltas). Steady cadences therefore take a byte per time,
+// and jittery or nearly-sorted ones rarely more than a few.
+//
+// Layout, all little-endian:
+//	header		magic "SMTC", version, fracBits, epoch year, leap table
+//				fingerprint, time count, block count, index offset, block size
+//	blocks		up to blockSize times each; a block also ends early if
+//				its times would span more seconds than the fixed-point
+//				values can hold (2^(62 - fracBits), 34 years by default)
+//	index		per block: file offset, position of its first time,
+//				and its base second
+//
+// Readers memory-map the file and decode any range of times by way of
+// the block index, straight into smart_instants, smart_tms, UTCColumns
+// or a TimeConverter's METs, with no strings involved. Times only mean
+// anything in the context they were written in; check matches() first.
+//
+// Example:
+/*
+
+TimeColumnWriter writer("events.stc");
+writer.write(conv, METs.data(), METs.size());
+writer.close();
+
+TimeColumnReader reader("events.stc");
+if (reader.isOpen() && reader.matches(TimeContext::getDefault())) {
+	std::vector<smart_instant> times(reader.size());
+	reader.read(0, times.size(), times.data());
+}
+
+*/
+
+#ifndef TIME_COLUMN_H
+#define TIME_COLUMN_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FileIO.h"
+#include "UTC_MET.h"
+#include "smart_instant.h"
+#include "smart_tm.h"
+
+#define TIME_COLUMN_MAGIC			(0x43544D53U)	// "SMTC"
+#define TIME_COLUMN_VERSION			(1)
+#define TIME_COLUMN_HEADER_SIZE		(56)
+#define TIME_COLUMN_INDEX_ENTRY_SIZE	(24)
+
+#define DEFAULT_COLUMN_BLOCK_SIZE	(4096)
+#define DEFAULT_COLUMN_FRAC_BITS	(32)
+#define MAX_COLUMN_FRAC_BITS		(40)
+
+// Hash of a context's leap table, which together with the epoch year
+// fixes what its epoch counts mean
+uint64_t leapTableFingerprint(const TimeContext& context);
+
+class TimeColumnWriter {
+public:
+	// Create (or truncate) the file at path for times in the given context,
+	// with at most blockSize times per block and fracBits bits of fraction
+	// (at most MAX_COLUMN_FRAC_BITS). The context is held for the lifetime
+	// of the writer (and must not be null); by default, the default context
+	// at construction.
+	TimeColumnWriter(const std::string& path, const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault(),
+		const size_t blockSize = DEFAULT_COLUMN_BLOCK_SIZE, const unsigned fracBits = DEFAULT_COLUMN_FRAC_BITS);
+
+	// Closes the file if close() was not called
+	~TimeColumnWriter();
+
+	TimeColumnWriter(const TimeColumnWriter&) = delete;
+	TimeColumnWriter& operator=(const TimeColumnWriter&) = delete;
+
+	// Was the file created, and has every write succeeded?
+	bool isOpen() const { return file.good(); }
+
+	size_t size() const { return count; }
+
+	// Append times, which should be valid in the writer's context
+	void write(const smart_instant& time);
+	void write(const smart_instant* times, const size_t n);
+	void write(const smart_tm* times, const size_t n);
+
+	// Append the times of n METs of conv's mission,
+	// whose context must be the writer's
+	void write(const TimeConverter& conv, const double* METs, const size_t n);
+	void write(const TimeConverter& conv, const size_t* wholeMETs, const double* fracMETs, const size_t n);
+
+	// Write out the last block, the index and the header.
+	// Returns false on any I/O error.
+	bool close();
+
+private:
+	void endBlock();
+
+	std::ofstream file;
+	std::shared_ptr<const TimeContext> context;
+	size_t blockSize;
+	unsigned fracBits;
+	bool closed;
+
+	size_t count;
+	uint64_t fileOffset;
+
+	// index entries so far, and the block being encoded:
+	// its times and its previous value and difference
+	std::vector<uint8_t> index;
+	std::vector<uint8_t> block;
+	size_t blockCount;
+	size_t inBlock;
+	long long blockBase;
+	uint64_t prevValue;
+	uint64_t prevDelta;
+};
+
+class TimeColumnReader {
+public:
+	// Map and check the file at path
+	explicit TimeColumnReader(const std::string& path);
+
+	// Was the file mapped, and are its header and index sound?
+	bool isOpen() const { return valid; }
+
+	long long epochYear() const { return epochYr; }
+	uint64_t leapFingerprint() const { return fingerprint; }
+	unsigned fractionBits() const { return fracBits; }
+
+	// Were the times written in a context with this one's epoch and leap table?
+	bool matches(const TimeContext& context) const;
+
+	size_t size() const { return count; }
+	size_t blockCount() const { return blocks.size(); }
+
+	// Position of the first time in a block, and its number of times
+	size_t blockStart(const size_t block) const { return blocks[block].first; }
+	size_t blockLength(const size_t block) const;
+
+	// Decode times [first, first + n), which must be within size(), into
+	// the output arrays. Returns false, leaving the output partly written,
+	// if the range is out of bounds or the file is corrupt.
+	// Results in a context other than the file's, see matches(), are meaningless.
+	bool read(const size_t first, const size_t n, smart_instant* timesOut) const;
+	bool read(const size_t first, const size_t n, smart_tm* timesOut, const TimeContext& context = TimeContext::getDefault()) const;
+	bool read(const size_t first, const size_t n, const UTCColumns& timesOut, const TimeContext& context = TimeContext::getDefault()) const;
+
+	// As METs of conv's mission, as TimeConverter::toMET() would give
+	bool readMETs(const TimeConverter& conv, const size_t first, const size_t n, double* METsOut) const;
+	bool readMETs(const TimeConverter& conv, const size_t first, const size_t n, size_t* wholeMETsOut, double* fracMETsOut) const;
+
+private:
+	struct Block {
+		uint64_t offset;
+		size_t first;
+		long long base;
+	};
+
+	// decode times [first, first + n), handing each to sink(i, time)
+	template <typename Sink>
+	bool decode(const size_t first, const size_t n, Sink sink) const;
+
+	MappedFile map;
+	bool valid;
+
+	long long epochYr;
+	uint64_t fingerprint;
+	unsigned fracBits;
+	size_t count;
+	uint64_t indexOffset;
+	std::vector<Block> blocks;
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*******************************************************************
+*   TimeContext.cpp
+*	Immutable epoch and leap second state
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// A TimeContext holds everything smart_tm needs beyond its own
+// fields: the epoch year and the leap second tables built from an
+// IETF/IERS leap second file. It is built once, all at once, and never
+// changes afterwards, so any number of threads may convert against it
+// at the same time without locking, and several can coexist in one
+// process, e.g. one with epoch 1990 and one with epoch 2001.
+
+#include "TimeContext.h"
+#include "smart_tm.h"
+#include "LeapTable.h"
+#include "TimeStats.h"
+
+TimeContext::TimeContext(const long long epochYr) : epochYr(epochYr), leapTableLoaded(false), expiryNTP(0), leapsBeforeEpoch(0),
+	epochLeapDays(smart_tm::leapDaysBefore(epochYr, START_MON, START_DAY)) {}
+
+std::shared_ptr<const TimeContext> TimeContext::create(const long long epochYr, const std::string& leapFile) {
+
+	std::ifstream fLeap(leapFile);
+
+	if (!fLeap) {
+		std::cerr << "ERROR: Failed to open " << leapFile << '.' << std::endl;
+		return nullptr;
+	}
+
+	std::vector<size_t> leapTimes;
+	size_t expiryNTP = 0;
+
+	std::string strLine;
+	while (getNextLine(fLeap, strLine, "#@")) {
+		// expiry date, also as seconds since 1900 ignoring leap seconds
+		if (strLine[0] == '#') {
+			expiryNTP = static_cast<size_t>(strtoull(strLine.c_str() + 2, nullptr, BASE_10_PLEASE));
+		}
+		else {
+			leapTimes.push_back(static_cast<size_t>(strtoull(strLine.substr(0, strLine.find_first_not_of("0123456789")).c_str(), nullptr, BASE_10_PLEASE)));
+		}
+	}
+
+	fLeap.close();
+
+	return create(epochYr, leapTimes.data(), leapTimes.size(), expiryNTP);
+}
+
+std::shared_ptr<const TimeContext> TimeContext::create(const long long epochYr) {
+	return create(epochYr, embeddedLeapTimes, EMBEDDED_LEAP_COUNT, EMBEDDED_LEAP_EXPIRY);
+}
+
+std::shared_ptr<const TimeContext> TimeContext::create(const long long epochYr, const size_t* leapTimes, const size_t n, const size_t expiryNTP) {
+	std::shared_ptr<TimeContext> context(new TimeContext(epochYr));
+	context->leapTableLoaded = true;
+	context->expiryNTP = expiryNTP;
+
+	// leap file gives leap second times as seconds since epoch with year 1900,
+	// but smart_tm allows users to specify an epoch, so we must get the number
+	// of seconds in between and subtract that from each leap second
+	const size_t defaultEpochToNewEpoch = numSecondsBetweenEpochs(DEFAULT_EPOCH_YEAR, epochYr);
+
+	size_t leapSecondsSoFar = 0;
+
+	for (size_t i = 0; i < n; ++i) {
+		const size_t defaultEpochToLeapSecond = leapTimes[i];
+
+		// the leap file gives time since 1900
+		// Unix-style, i.e. ignoring leap seconds.
+		// smart_tm does not conform to this behavior, instead considering
+		// epoch a monotonic counter INCLUDING leap seconds.
+		// Therefore we must manually add 1 second to the leap file time
+		// for each leap second we've already passed.
+		if (defaultEpochToLeapSecond > defaultEpochToNewEpoch) {
+			context->leapSecondNonleapEpochs.push_back(static_cast<long long>(defaultEpochToLeapSecond - defaultEpochToNewEpoch));
+			context->leapSecondDeltas.push_back(defaultEpochToLeapSecond - defaultEpochToNewEpoch + leapSecondsSoFar++);
+
+			// the leap second is inserted right before the listed (nonleap)
+			// time, i.e. as second '60' of the last minute before it
+			context->leapMinuteOrdinals.push_back(static_cast<long long>(defaultEpochToLeapSecond / TYPICAL_SECONDS_PER_MINUTE) - 1);
+		}
+		else {
+			++context->leapsBeforeEpoch;
+		}
+	}
+
+	return context;
+}
+
+TimeContext::DefaultState::DefaultState() {
+	published.push_back(std::shared_ptr<const TimeContext>(new TimeContext(DEFAULT_EPOCH_YEAR)));
+	current.store(published.back().get());
+}
+
+TimeContext::DefaultState& TimeContext::defaultState() {
+	// constructed on first use, so smart_tm objects with static
+	// storage duration can safely use it from their own constructors
+	static DefaultState state;
+	return state;
+}
+
+const TimeContext& TimeContext::getDefault() {
+	return *defaultState().current.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const TimeContext> TimeContext::sharedDefault() {
+	DefaultState& state = defaultState();
+	std::lock_guard<std::mutex> guard(state.lock);
+	return state.published.back();
+}
+
+void TimeContext::setDefault(const std::shared_ptr<const TimeContext>& context) {
+	if (!context) return;
+
+	// readers never take the lock; it only orders publishers
+	DefaultState& state = defaultState();
+	std::lock_guard<std::mutex> guard(state.lock);
+	state.published.push_back(context);
+	state.current.store(context.get(), std::memory_order_release);
+}
+
+std::shared_ptr<const TimeContext> TimeContext::reload(const std::string& leapFile) {
+	// all the parsing happens here, before anything is published
+	std::shared_ptr<const TimeContext> context = create(getDefault().epochYear(), leapFile);
+	setDefault(context);
+	return context;
+}
+
+long long TimeContext::secondsUntilExpiry() const {
+	const long long now = static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+	return static_cast<long long>(expiryNTP) - NTP_TO_UNIX_SECONDS - now;
+}
+
+void TimeContext::checkInit() const {
+	if (!leapTableLoaded) {
+		TIME_STATS_COUNT(CheckInitWarnings);
+		std::cerr << "WARN: smart_tm not initialized! This means no leap second handling" << std::endl
+			<< "and default epoch of " << DEFAULT_EPOCH_YEAR << '.' << std::endl;
+	}
+}
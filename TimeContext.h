@@ -0,0 +1,168 @@
+/*******************************************************************
+*   TimeContext.h
+*	Immutable epoch and leap second state
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// A TimeContext holds everything smart_tm needs beyond its own
+// fields: the epoch year and the leap second tables built from an
+// IETF/IERS leap second file. It is built once, all at once, and never
+// changes afterwards, so any number of threads may convert against it
+// at the same time without locking, and several can coexist in one
+// process, e.g. one with epoch 1990 and one with epoch 2001.
+//
+// Every smart_tm and TimeConverter call that depends on the epoch or
+// on leap seconds takes an optional context. Calls without one use
+// the default context, which is what smart_tm::init() sets up, so
+// existing code using the static API is unchanged.
+//
+// Contexts are handed out as shared_ptr<const TimeContext>. Hold on to
+// one for as long as anything converts against it. In particular,
+// replacing the default via smart_tm::init() or setDefault() does not
+// affect contexts, or TimeConverters, already obtained.
+//
+// The default context can be replaced at any time, e.g. by reload()
+// when a newer leap-seconds.list is published, without pausing
+// conversion: the new table is built entirely by the caller, then
+// published with a single atomic pointer swap. Calls already under way
+// finish against the table they started with, and every default
+// context ever published stays alive until exit, so references from
+// getDefault() never dangle. Leap files are republished about twice a
+// year, so what this keeps around is negligible.
+//
+// The file's expiry date (its '#@' line) is kept, so long-running
+// processes can check secondsUntilExpiry() and alert before it passes.
+//
+// Example with two epochs side by side:
+/*
+
+std::shared_ptr<const TimeContext> ctx1990 = TimeContext::create(1990, "leap-seconds.list");
+std::shared_ptr<const TimeContext> ctx2001 = TimeContext::create(2001, "leap-seconds.list");
+
+const smart_tm t(2012, 6, 30, 23, 59, 60, 0.0);
+std::cout << t.toEpoch(*ctx1990) << ' ' << t.toEpoch(*ctx2001) << std::endl;
+
+const smart_tm launch(2008, 6, 11, 16, 5, 0, 0.0);
+TimeConverter conv(launch, ctx2001);
+
+*/
+
+#ifndef TIME_CONTEXT_H
+#define TIME_CONTEXT_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// seconds from 1900-01-01 00:00:00, the NTP epoch of the
+// leap file's timestamps, to 1970-01-01 00:00:00, the system_clock epoch
+#define NTP_TO_UNIX_SECONDS			(2208988800LL)
+
+class TimeContext {
+public:
+	// Create a context with epoch at the first second of epochYr
+	// and leap seconds from the official IERS leap seconds file,
+	// typically named 'leap-seconds.list'.
+	// Returns nullptr if the file cannot be opened.
+	static std::shared_ptr<const TimeContext> create(const long long epochYr, const std::string& leapFile);
+
+	// As above, but from the leap table built into the program
+	// (see LeapTable.h), without any file I/O
+	static std::shared_ptr<const TimeContext> create(const long long epochYr);
+
+	// As above, from n leap file entries given as seconds since 1900
+	// ignoring leap seconds, ascending, and the file's expiry (0 if none)
+	static std::shared_ptr<const TimeContext> create(const long long epochYr, const size_t* leapTimes, const size_t n, const size_t expiryNTP);
+
+	// The context used by calls that are not given one.
+	// Until smart_tm::init() or setDefault() is called, this has the
+	// default epoch year and no leap seconds.
+	static const TimeContext& getDefault();
+	static std::shared_ptr<const TimeContext> sharedDefault();
+
+	// Atomically replace the default context. Safe while other threads
+	// convert against the old one, which they keep until their call is done.
+	// Ignored if context is nullptr.
+	static void setDefault(const std::shared_ptr<const TimeContext>& context);
+
+	// Build a context from leapFile for the default context's epoch year
+	// and, if successful, make it the default as in setDefault().
+	// Returns the new default, or nullptr (keeping the old one)
+	// if the file cannot be opened.
+	static std::shared_ptr<const TimeContext> reload(const std::string& leapFile);
+
+	// Year whose first second is epoch
+	long long epochYear() const { return epochYr; }
+
+	// Were leap seconds imported, from a file or the built-in table?
+	bool initialized() const { return leapTableLoaded; }
+
+	// Warn user if leap seconds have not been imported
+	void checkInit() const;
+
+	// Seconds since epoch of each leap second itself, sorted ascending
+	const std::vector<size_t>& leapSecondEpochs() const { return leapSecondDeltas; }
+
+	// Leap file entries at or before epoch, which leapSecondEpochs() leaves out
+	size_t leapSecondsBeforeEpoch() const { return leapsBeforeEpoch; }
+
+	// Does the leap file state when it expires?
+	bool hasExpiry() const { return expiryNTP != 0; }
+
+	// The leap file's expiry, as listed: seconds since 1900 ignoring
+	// leap seconds (NTP time). 0 if the file gave none.
+	size_t expiry() const { return expiryNTP; }
+
+	// Seconds from now, per the system clock, to the leap file's expiry;
+	// negative once it has passed. Meaningless if !hasExpiry().
+	long long secondsUntilExpiry() const;
+
+private:
+	// Empty context: epoch at the first second of epochYr, no leap seconds
+	explicit TimeContext(const long long epochYr);
+
+	// The published default contexts, oldest first, all kept alive,
+	// and the current one, loaded without locking by getDefault()
+	struct DefaultState {
+		std::mutex lock;
+		std::vector<std::shared_ptr<const TimeContext> > published;
+		std::atomic<const TimeContext*> current;
+
+		DefaultState();
+	};
+
+	static DefaultState& defaultState();
+
+	long long epochYr;
+	bool leapTableLoaded;
+	size_t expiryNTP;
+	size_t leapsBeforeEpoch;
+
+	// leapDaysBefore() of epoch, since the epoch side
+	// of every toEpoch() leap day correction is the same
+	long long epochLeapDays;
+
+	// Minute ordinal (see smart_tm::minuteOrdinal()) of each minute containing
+	// a leap second, sorted ascending, for constant-time isLeapMinute()
+	std::vector<long long> leapMinuteOrdinals;
+
+	// Seconds since epoch of each leap second itself, sorted ascending
+	std::vector<size_t> leapSecondDeltas;
+
+	// Leap second index: the nonleap seconds since epoch
+	// (i.e. with every day exactly SECONDS_PER_DAY long) of the first moment
+	// after each leap second, sorted ascending. The number of leap seconds
+	// before a time is then the number of entries at or below its nonleap count,
+	// found by binary search instead of smart_tm comparisons.
+	std::vector<long long> leapSecondNonleapEpochs;
+
+	friend class smart_tm;
+};
+
+#endif
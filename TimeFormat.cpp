@@ -0,0 +1,166 @@
+/*******************************************************************
+*   TimeFormat.cpp
+*	Compiled, allocation-free smart_tm output patterns
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// TimeFormat compiles a strftime-like pattern once and then writes
+// smart_tms into caller buffers with fixed-width digits, no
+// allocation and no locale or stream machinery, for bulk output of
+// formatted times (e.g. CSV or sidecar files).
+
+#include "TimeFormat.h"
+
+// the most any single op can write: a long long with sign
+#define OP_BUFFER_SIZE				(24)
+
+static const long long powersOf10[MAX_FRAC_DIGITS + 1] = {
+	1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+	10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+	1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+};
+
+// Write value in exactly width digits if it fits, which every field
+// of a valid time does; otherwise fall back to writePadded()
+static inline char* writeFixed(char* out, const long long value, const int width) {
+	if (value < 0 || value >= powersOf10[width]) return writePadded(out, value, width);
+
+	unsigned long long v = static_cast<unsigned long long>(value);
+	for (int i = width - 1; i >= 0; --i) {
+		out[i] = static_cast<char>('0' + v % BASE_10_PLEASE);
+		v /= BASE_10_PLEASE;
+	}
+	return out + width;
+}
+
+TimeFormat::TimeFormat(const std::string& pattern) : len(0) {
+	for (size_t i = 0; i < pattern.size(); ++i) {
+		Field field = LITERAL;
+		size_t arg = 0;
+		char literal = pattern[i];
+
+		if (pattern[i] == '%' && i + 1 < pattern.size()) {
+			// optional digit count, only meaningful before 'f'
+			size_t j = i + 1;
+			size_t count = 0;
+			while (j < pattern.size() && pattern[j] >= '0' && pattern[j] <= '9' && count <= MAX_FRAC_DIGITS) {
+				count = count * BASE_10_PLEASE + (pattern[j++] - '0');
+			}
+			const bool hasCount = j > i + 1;
+			const char spec = (j < pattern.size()) ? pattern[j] : '\0';
+
+			if (spec == 'f' && (!hasCount || (count >= 1 && count <= MAX_FRAC_DIGITS))) {
+				field = FRAC_SEC;
+				arg = hasCount ? count : DEFAULT_FRAC_DIGITS;
+				i = j;
+			}
+			else if (!hasCount) {
+				switch (spec) {
+				case 'Y': field = YEAR; break;
+				case 'm': field = MONTH; break;
+				case 'd': field = DAY; break;
+				case 'j': field = DAY_OF_YEAR; break;
+				case 'H': field = HOUR; break;
+				case 'M': field = MINUTE; break;
+				case 'S': field = SECOND; break;
+				case '%': break;
+				default: --i; break;
+				}
+				// unknown specifiers are copied literally, '%' included
+				++i;
+			}
+		}
+
+		switch (field) {
+		case LITERAL:
+			// extend the current run of literal text, or start a new one
+			if (ops.empty() || ops.back().field != LITERAL) {
+				const Op op = { LITERAL, literals.size(), 0 };
+				ops.push_back(op);
+			}
+			literals += literal;
+			++ops.back().litLen;
+			len += 1;
+			continue;
+		case YEAR: len += 4; break;
+		case DAY_OF_YEAR: len += 3; break;
+		case FRAC_SEC: len += arg; break;
+		default: len += 2; break;
+		}
+
+		const Op op = { field, arg, 0 };
+		ops.push_back(op);
+	}
+}
+
+char* TimeFormat::writeOp(const Op& op, const smart_tm& time, char* out) const {
+	switch (op.field) {
+	case YEAR: return writeFixed(out, time.yr, 4);
+	case MONTH: return writeFixed(out, time.mon, 2);
+	case DAY: return writeFixed(out, time.day, 2);
+	case DAY_OF_YEAR: return writeFixed(out, time.dayOfYear(), 3);
+	case HOUR: return writeFixed(out, time.hr, 2);
+	case MINUTE: return writeFixed(out, time.min, 2);
+	case SECOND: return writeFixed(out, time.sec, 2);
+	case FRAC_SEC: {
+		// rounded, but clamped so as never to carry into the seconds
+		const double scale = static_cast<double>(powersOf10[op.arg]);
+		const double scaled = floor(time.fracSec * scale + 0.5);
+		const long long digits = (scaled >= scale) ? powersOf10[op.arg] - 1 : (scaled > 0.0) ? static_cast<long long>(scaled) : 0;
+		return writeFixed(out, digits, static_cast<int>(op.arg));
+	}
+	default:
+		return out;
+	}
+}
+
+size_t TimeFormat::format(const smart_tm& time, char* buf, const size_t cap) const {
+	char* out = buf;
+	char* const end = buf + cap;
+	char opText[OP_BUFFER_SIZE];
+
+	for (auto&& op : ops) {
+		if (op.field == LITERAL) {
+			if (op.litLen > static_cast<size_t>(end - out)) return FORMAT_NO_FIT;
+			memcpy(out, literals.data() + op.arg, op.litLen);
+			out += op.litLen;
+		}
+		else if (end - out >= OP_BUFFER_SIZE) {
+			// plenty of room; write in place
+			out = writeOp(op, time, out);
+		}
+		else {
+			// near the end; write aside and check it fits
+			const size_t opLen = writeOp(op, time, opText) - opText;
+			if (opLen > static_cast<size_t>(end - out)) return FORMAT_NO_FIT;
+			memcpy(out, opText, opLen);
+			out += opLen;
+		}
+	}
+
+	if (out < end) *out = '\0';
+	return out - buf;
+}
+
+size_t TimeFormat::format(const smart_tm* times, const size_t n, char* buf, const size_t cap, size_t& timesWritten, const char terminator /* ='\n' */) const {
+	size_t written = 0;
+	for (timesWritten = 0; timesWritten < n; ++timesWritten) {
+		// need room for the terminator too
+		const size_t timeLen = format(times[timesWritten], buf + written, cap - written);
+		if (timeLen == FORMAT_NO_FIT || written + timeLen >= cap) break;
+
+		written += timeLen;
+		buf[written++] = terminator;
+	}
+	return written;
+}
+
+std::string TimeFormat::toString(const smart_tm& time) const {
+	std::string ret(len + OP_BUFFER_SIZE * ops.size(), '\0');
+	ret.resize(format(time, &ret[0], ret.size()));
+	return ret;
+}
@@ -0,0 +1,97 @@
+/*******************************************************************
+*   TimeFormat.h
+*	Compiled, allocation-free smart_tm output patterns
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// TimeFormat compiles a strftime-like pattern once and then writes
+// smart_tms into caller buffers with fixed-width digits, no
+// allocation and no locale or stream machinery, for bulk output of
+// formatted times (e.g. CSV or sidecar files).
+//
+// Pattern specifiers:
+//	%Y	year, 4 digits			%m	month, 2 digits
+//	%d	day, 2 digits			%j	day of year, 3 digits
+//	%H	hour, 2 digits			%M	minute, 2 digits
+//	%S	second, 2 digits (60 during a leap second)
+//	%f	fractional second, 6 digits
+//	%Nf	fractional second, N digits (1 to 18)
+//	%%	a literal '%'
+// Everything else, e.g. '/', '-', ':', ' ', 'T' or 'Z', is copied as is.
+//
+// Fractional digits are rounded to nearest, except that they never
+// round up into the seconds (0.9999999 with %3f gives .999), so the
+// other fields are always written exactly as they are.
+//
+// Example use, writing ISO 8601:
+/*
+
+const TimeFormat iso("%Y-%m-%dT%H:%M:%S.%3fZ");
+char buf[64];
+size_t len = iso.format(smart_tm(2012, 6, 30, 23, 59, 60, 0.5), buf, sizeof(buf));
+// buf now holds "2012-06-30T23:59:60.500Z"
+
+*/
+
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "smart_tm.h"
+
+#define DEFAULT_FRAC_DIGITS			(6)
+#define MAX_FRAC_DIGITS				(18)
+
+// returned by format() when the text does not fit, as distinct from
+// the empty text of e.g. an empty pattern
+#define FORMAT_NO_FIT				(SIZE_MAX)
+
+class TimeFormat {
+public:
+	explicit TimeFormat(const std::string& pattern);
+
+	// Write time into buf, followed by a terminating null if there is room.
+	// Returns the number of characters written, not counting the null,
+	// or FORMAT_NO_FIT if they do not fit in cap.
+	size_t format(const smart_tm& time, char* buf, const size_t cap) const;
+
+	// Write n times into buf, each followed by terminator, stopping
+	// before the first that would not fit. Returns the number of
+	// characters written and sets timesWritten. No terminating null.
+	size_t format(const smart_tm* times, const size_t n, char* buf, const size_t cap, size_t& timesWritten, const char terminator='\n') const;
+
+	std::string toString(const smart_tm& time) const;
+
+	// Length of the output for any valid time
+	size_t length() const { return len; }
+
+private:
+	enum Field {
+		LITERAL, YEAR, MONTH, DAY, DAY_OF_YEAR, HOUR, MINUTE, SECOND, FRAC_SEC
+	};
+
+	struct Op {
+		Field	field;
+		// the digit count for FRAC_SEC; for LITERAL, the position
+		// and length of the run of literal text in 'literals'
+		size_t	arg;
+		size_t	litLen;
+	};
+
+	std::vector<Op> ops;
+	std::string literals;
+	size_t len;
+
+	// Write a single non-literal op at out, which must have room for
+	// OP_BUFFER_SIZE characters. Return one past the last written.
+	char* writeOp(const Op& op, const smart_tm& time, char* out) const;
+};
+
+#endif
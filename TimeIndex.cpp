@@ -0,0 +1,204 @@
+/*******************************************************************
+*   TimeIndex.cpp
+*	Sorted, searchable index over large collections of times
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include <algorithm>
+
+#include "TimeIndex.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(p)					__builtin_prefetch(p)
+#else
+#include <xmmintrin.h>
+#define PREFETCH(p)					_mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#endif
+
+// 8-bit digits, so 8 passes at most over the 64-bit key
+#define RADIX_BITS					(8)
+#define RADIX_BUCKETS				(1 << RADIX_BITS)
+#define RADIX_PASSES				(64 / RADIX_BITS)
+
+// Eytzinger nodes this many levels below the current one are prefetched;
+// with 8-byte keys and the tree aligned to a cache line, all 2^3 of them
+// share one line
+#define PREFETCH_LEVELS				(3)
+#define TREE_ALIGNMENT				(64)
+
+// std::partition_point() over [first, last), for a partition point
+// usually at or near first: gallops out from first, then binary searches
+// the last gallop, for O(log d) steps to a partition point d elements in
+template <typename It, typename Pred>
+static It gallopingPartitionPoint(It first, const It last, const Pred pred) {
+	size_t step = 1;
+	while (static_cast<size_t>(last - first) > step && pred(first[step])) {
+		first += step;
+		step *= 2;
+	}
+	return std::partition_point(first, first + std::min(step + 1, static_cast<size_t>(last - first)), pred);
+}
+
+TimeIndex::TimeIndex(const smart_tm* times, const size_t n, const TimeContext& context /* =TimeContext::getDefault() */) {
+	sorted.resize(n);
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		sorted[i].time = smart_instant(times[i], leapHint, context);
+		sorted[i].index = i;
+	}
+	build();
+}
+
+TimeIndex::TimeIndex(const smart_instant* instants, const size_t n) {
+	sorted.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		sorted[i].time = instants[i];
+		sorted[i].index = i;
+	}
+	build();
+}
+
+void TimeIndex::build() {
+	radixSort(sorted);
+
+	// with node 0 (unused) on a cache line boundary, the descendants of
+	// node k PREFETCH_LEVELS down, k << PREFETCH_LEVELS onward, share a line
+	const size_t perLine = TREE_ALIGNMENT / sizeof(long long);
+	treeStorage.assign(sorted.size() + 1 + perLine, 0);
+	const size_t misalignment = (reinterpret_cast<uintptr_t>(treeStorage.data()) % TREE_ALIGNMENT) / sizeof(long long);
+	treeOffset = misalignment ? perLine - misalignment : 0;
+
+	treeRank.resize(sorted.size() + 1);
+	layOut(0, 1);
+}
+
+void TimeIndex::radixSort(std::vector<Entry>& entries) {
+	const size_t n = entries.size();
+	if (n < 2) return;
+
+	// flipping the sign bit orders signed seconds as unsigned keys
+	const uint64_t signBit = 1ULL << 63;
+
+	// histograms of every digit in a single pass
+	std::vector<size_t> counts(RADIX_PASSES * RADIX_BUCKETS, 0);
+	for (const Entry& entry : entries) {
+		const uint64_t key = static_cast<uint64_t>(entry.time.sinceEpoch) ^ signBit;
+		for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+			++counts[pass * RADIX_BUCKETS + ((key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1))];
+		}
+	}
+
+	std::vector<Entry> buffer(n);
+	Entry* src = entries.data();
+	Entry* dst = buffer.data();
+	for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+		size_t* bucket = &counts[pass * RADIX_BUCKETS];
+		const size_t shift = pass * RADIX_BITS;
+
+		// a digit shared by every key leaves the order as it is
+		const uint64_t firstKey = static_cast<uint64_t>(src[0].time.sinceEpoch) ^ signBit;
+		if (bucket[(firstKey >> shift) & (RADIX_BUCKETS - 1)] == n) continue;
+
+		size_t offset = 0;
+		for (size_t i = 0; i < RADIX_BUCKETS; ++i) {
+			const size_t count = bucket[i];
+			bucket[i] = offset;
+			offset += count;
+		}
+
+		for (size_t i = 0; i < n; ++i) {
+			const uint64_t key = static_cast<uint64_t>(src[i].time.sinceEpoch) ^ signBit;
+			dst[bucket[(key >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+	if (src != entries.data()) std::copy(src, src + n, entries.data());
+
+	// the sort is stable, so times in the same second are still in input
+	// order; order those runs, typically short, by fraction
+	for (size_t begin = 0; begin < n; ) {
+		size_t end = begin + 1;
+		while (end < n && entries[end].time.sinceEpoch == entries[begin].time.sinceEpoch) ++end;
+		if (end - begin > 1) {
+			std::stable_sort(entries.begin() + begin, entries.begin() + end,
+				[](const Entry& lhs, const Entry& rhs) { return lhs.time.frac < rhs.time.frac; });
+		}
+		begin = end;
+	}
+}
+
+size_t TimeIndex::layOut(size_t i, const size_t k) {
+	if (k <= sorted.size()) {
+		i = layOut(i, 2 * k);
+		treeStorage[treeOffset + k] = sorted[i].time.sinceEpoch;
+		treeRank[k] = i++;
+		i = layOut(i, 2 * k + 1);
+	}
+	return i;
+}
+
+size_t TimeIndex::firstSecondAtOrAfter(const long long sinceEpoch) const {
+	const size_t n = sorted.size();
+	const long long* keys = treeStorage.data() + treeOffset;
+
+	// go right past every key before the bound...
+	size_t k = 1;
+	while (k <= n) {
+		// clamped so as never to form a pointer past the end of the tree
+		PREFETCH(keys + std::min(k << PREFETCH_LEVELS, n));
+		k = 2 * k + static_cast<size_t>(keys[k] < sinceEpoch);
+	}
+
+	// ...and the answer is the last node where the walk went left:
+	// strip the trailing right turns (1 bits) and that left turn
+	while (k & 1) k >>= 1;
+	k >>= 1;
+
+	return k ? treeRank[k] : n;
+}
+
+size_t TimeIndex::lowerBound(const smart_instant& time) const {
+	// the tree holds whole seconds only; times in the same second as
+	// the bound, which all come first from there on, are then settled
+	// by fraction with a search over that run, however many events
+	// share it
+	const std::vector<Entry>::const_iterator first = sorted.begin() + firstSecondAtOrAfter(time.sinceEpoch);
+	return gallopingPartitionPoint(first, sorted.end(), [&](const Entry& entry) { return entry.time < time; }) - sorted.begin();
+}
+
+size_t TimeIndex::upperBound(const smart_instant& time) const {
+	const std::vector<Entry>::const_iterator first = sorted.begin() + firstSecondAtOrAfter(time.sinceEpoch);
+	return gallopingPartitionPoint(first, sorted.end(), [&](const Entry& entry) { return !(time < entry.time); }) - sorted.begin();
+}
+
+size_t TimeIndex::lowerBound(const smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	return lowerBound(smart_instant(time, context));
+}
+
+size_t TimeIndex::upperBound(const smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	return upperBound(smart_instant(time, context));
+}
+
+std::pair<size_t, size_t> TimeIndex::range(const smart_instant& from, const smart_instant& to) const {
+	const size_t first = lowerBound(from);
+	return std::make_pair(first, std::max(first, lowerBound(to)));
+}
+
+std::pair<size_t, size_t> TimeIndex::range(const smart_tm& from, const smart_tm& to, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	return range(smart_instant(from, context), smart_instant(to, context));
+}
+
+std::pair<size_t, size_t> TimeIndex::range(const TimeConverter& conv, const double fromMET, const double toMET) const {
+	// METs count leap-aware seconds from the mission start, so the bounds
+	// are just offsets from it, split as TimeConverter::toUTC() does
+	double startFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+
+	const double fromWhole = floor(fromMET), toWhole = floor(toMET);
+	return range(smart_instant::fromEpoch(startEpoch + static_cast<long long>(fromWhole), startFracSec + (fromMET - fromWhole)),
+		smart_instant::fromEpoch(startEpoch + static_cast<long long>(toWhole), startFracSec + (toMET - toWhole)));
+}
@@ -0,0 +1,111 @@
+/*******************************************************************
+*   TimeIndex.h
+*	Sorted, searchable index over large collections of times
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Answers "which events fall between these two times?" over large
+// collections of timestamps.
+//
+// Building the index converts each time to a smart_instant once, then
+// sorts by LSD radix sort on the 64-bit seconds key (one pass per byte
+// that actually varies, so typically 4 or 5), settling times within
+// the same second by their fractions. For searching, the sorted seconds
+// are also laid out in Eytzinger (breadth-first binary tree) order, where
+// the next few levels of any search sit together in memory and can be
+// prefetched, so lower and upper bounds take a branch-free walk down
+// the tree instead of binary search's cache misses.
+//
+// Results are positions in sorted order; time(pos) and index(pos) give
+// each event's time and its position in the original input.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+const TimeIndex index(events.data(), events.size());
+
+const std::pair<size_t, size_t> hits = index.range(smart_tm(2012, 6, 30, 0, 0, 0, 0.0), smart_tm(2012, 7, 1, 0, 0, 0, 0.0));
+for (size_t pos = hits.first; pos < hits.second; ++pos) {
+	const size_t event = index.index(pos);
+	...
+}
+
+// or by MET
+const std::pair<size_t, size_t> orbit = index.range(conv, 1000.0, 6700.0);
+
+*/
+
+#ifndef TIME_INDEX_H
+#define TIME_INDEX_H
+
+#include <utility>
+#include <vector>
+
+#include "UTC_MET.h"
+#include "smart_instant.h"
+#include "smart_tm.h"
+
+class TimeIndex {
+public:
+	TimeIndex() : treeOffset(0) {}
+
+	// Index n times, which must be valid in the given context
+	TimeIndex(const smart_tm* times, const size_t n, const TimeContext& context = TimeContext::getDefault());
+	TimeIndex(const smart_instant* instants, const size_t n);
+
+	size_t size() const { return sorted.size(); }
+
+	// Sorted position of the first time not before (lowerBound) or
+	// after (upperBound) the given one, or size() if there is none
+	size_t lowerBound(const smart_instant& time) const;
+	size_t upperBound(const smart_instant& time) const;
+	size_t lowerBound(const smart_tm& time, const TimeContext& context = TimeContext::getDefault()) const;
+	size_t upperBound(const smart_tm& time, const TimeContext& context = TimeContext::getDefault()) const;
+
+	// Sorted positions [first, second) of the times in [from, to)
+	std::pair<size_t, size_t> range(const smart_instant& from, const smart_instant& to) const;
+	std::pair<size_t, size_t> range(const smart_tm& from, const smart_tm& to, const TimeContext& context = TimeContext::getDefault()) const;
+
+	// As above, with the bounds as METs of the given converter's mission,
+	// whose context must be the one the index was built in
+	std::pair<size_t, size_t> range(const TimeConverter& conv, const double fromMET, const double toMET) const;
+
+	// The time at a sorted position, and its position in the original input
+	const smart_instant& time(const size_t pos) const { return sorted[pos].time; }
+	size_t index(const size_t pos) const { return sorted[pos].index; }
+
+private:
+	struct Entry {
+		smart_instant time;
+		size_t index;
+	};
+
+	void build();
+
+	// sort entries by time, ties by original position
+	static void radixSort(std::vector<Entry>& entries);
+
+	// place sorted[i, ...) in the subtree rooted at Eytzinger node k,
+	// returning the next unplaced i
+	size_t layOut(size_t i, const size_t k);
+
+	// the Eytzinger walk: sorted position of the first time
+	// in or after the given second
+	size_t firstSecondAtOrAfter(const long long sinceEpoch) const;
+
+	std::vector<Entry> sorted;
+
+	// whole seconds of the sorted times in 1-based Eytzinger order,
+	// starting treeOffset elements into treeStorage so as to be
+	// cache-line aligned, and each node's sorted position
+	std::vector<long long> treeStorage;
+	size_t treeOffset;
+	std::vector<size_t> treeRank;
+};
+
+#endif
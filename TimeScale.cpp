@@ -0,0 +1,220 @@
+/*******************************************************************
+*   TimeScale.cpp
+*	UTC, TAI, GPS and TT time scales on the leap-aware epoch count
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include "TimeScale.h"
+#include "smart_clock.h"
+
+TimeScale::TimeScale(const Scale scale, const std::shared_ptr<const TimeContext>& context /* =TimeContext::sharedDefault() */)
+	: context(context), which(scale), offset(0), fracOffset(0.0) {
+	context->checkInit();
+
+	// TAI - UTC at epoch, and so between TAI and the epoch count ever after
+	const long long taiMinusUTC = TAI_MINUS_UTC_BEFORE_LEAPS + static_cast<long long>(context->leapSecondsBeforeEpoch());
+	const long long epochDays = daysFromCivil(context->epochYear(), START_MON, START_DAY);
+
+	switch (scale) {
+	case TAI:
+		offset = (epochDays - daysFromCivil(TAI_ORIGIN_YR, START_MON, START_DAY)) * SECONDS_PER_DAY + taiMinusUTC;
+		break;
+	case GPS:
+		offset = (epochDays - daysFromCivil(GPS_ORIGIN_YR, GPS_ORIGIN_MON, GPS_ORIGIN_DAY)) * SECONDS_PER_DAY + taiMinusUTC - TAI_MINUS_GPS_SECONDS;
+		break;
+	case TT:
+		offset = (epochDays - daysFromCivil(J2000_YR, START_MON, START_DAY)) * SECONDS_PER_DAY - J2000_SECONDS_INTO_DAY + taiMinusUTC + TT_MINUS_TAI_SECONDS;
+		fracOffset = TT_MINUS_TAI_FRAC_SEC;
+		break;
+	default:
+		break;
+	}
+}
+
+const char* TimeScale::name(const Scale scale) {
+	static const char* const names[ScaleCount] = { "UTC", "TAI", "GPS", "TT" };
+	return scale < ScaleCount ? names[scale] : "unknown";
+}
+
+long long TimeScale::split(const double seconds, double& fracSecOut) {
+	const double whole = floor(seconds);
+	fracSecOut = seconds - whole;
+	return static_cast<long long>(whole);
+}
+
+long long TimeScale::fromEpoch(const long long sinceEpoch, const double fracSec, double& fracSecOut) const {
+	fracSecOut = fracSec;
+	if (which == UTC) return smart_clock::toUnixSeconds(sinceEpoch, *context);
+
+	long long seconds = sinceEpoch + offset;
+	fracSecOut += fracOffset;
+	if (fracSecOut >= 1.0) {
+		fracSecOut -= 1.0;
+		++seconds;
+	}
+	return seconds;
+}
+
+long long TimeScale::toEpoch(const long long seconds, const double fracSec, double& fracSecOut) const {
+	fracSecOut = fracSec;
+	if (which == UTC) return smart_clock::fromUnixSeconds(seconds, *context);
+
+	long long sinceEpoch = seconds - offset;
+	fracSecOut -= fracOffset;
+	if (fracSecOut < 0.0) {
+		fracSecOut += 1.0;
+		--sinceEpoch;
+	}
+	return sinceEpoch;
+}
+
+long long TimeScale::fromTM(const smart_tm& time, double& fracSecOut) const {
+	// Unix time straight from the fields, where second '60'
+	// lands on the next minute by itself
+	if (which == UTC) {
+		fracSecOut = time.fracSec;
+		return (daysFromCivil(time.yr, time.mon, time.day) * SECONDS_PER_DAY - NTP_TO_UNIX_SECONDS) + (time.hr - START_HR) * SECONDS_PER_HOUR +
+			(time.min - START_MIN) * TYPICAL_SECONDS_PER_MINUTE + (time.sec - START_SEC);
+	}
+
+	double fracSec;
+	const long long sinceEpoch = static_cast<long long>(time.toEpoch(fracSec, *context));
+	return fromEpoch(sinceEpoch, fracSec, fracSecOut);
+}
+
+double TimeScale::fromTM(const smart_tm& time) const {
+	double fracSec;
+	const long long seconds = fromTM(time, fracSec);
+	return static_cast<double>(seconds) + fracSec;
+}
+
+smart_tm TimeScale::toTM(const long long seconds, const double fracSec) const {
+	double epochFracSec;
+	const long long sinceEpoch = toEpoch(seconds, fracSec, epochFracSec);
+	return smart_tm(static_cast<size_t>(sinceEpoch), epochFracSec, *context);
+}
+
+smart_tm TimeScale::toTM(const double seconds) const {
+	double fracSec;
+	const long long whole = split(seconds, fracSec);
+	return toTM(whole, fracSec);
+}
+
+long long TimeScale::convert(const long long seconds, const double fracSec, const TimeScale& to, double& fracSecOut) const {
+	if (to.which == which) {
+		fracSecOut = fracSec;
+		return seconds;
+	}
+	double epochFracSec;
+	const long long sinceEpoch = toEpoch(seconds, fracSec, epochFracSec);
+	return to.fromEpoch(sinceEpoch, epochFracSec, fracSecOut);
+}
+
+double TimeScale::convert(const double seconds, const TimeScale& to) const {
+	double fracSec, scaleFracSec;
+	const long long whole = split(seconds, fracSec);
+	const long long converted = convert(whole, fracSec, to, scaleFracSec);
+	return static_cast<double>(converted) + scaleFracSec;
+}
+
+double TimeScale::toMET(const TimeConverter& conv, const long long seconds, const double fracSec) const {
+	double startFracSec, epochFracSec;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	const long long sinceEpoch = toEpoch(seconds, fracSec, epochFracSec);
+	return static_cast<double>(sinceEpoch - startEpoch) + (epochFracSec - startFracSec);
+}
+
+double TimeScale::toMET(const TimeConverter& conv, const double seconds) const {
+	double fracSec;
+	const long long whole = split(seconds, fracSec);
+	return toMET(conv, whole, fracSec);
+}
+
+long long TimeScale::fromMET(const TimeConverter& conv, const double MET, double& fracSecOut) const {
+	// METs count leap-aware seconds from the mission start,
+	// so they are offsets on the epoch count, as in toUTC()
+	double startFracSec, fracMET;
+	const long long startEpoch = static_cast<long long>(conv.missionStart(startFracSec));
+	long long sinceEpoch = startEpoch + split(MET, fracMET);
+	double epochFracSec = startFracSec + fracMET;
+	if (epochFracSec >= 1.0) {
+		epochFracSec -= 1.0;
+		++sinceEpoch;
+	}
+	return fromEpoch(sinceEpoch, epochFracSec, fracSecOut);
+}
+
+double TimeScale::fromMET(const TimeConverter& conv, const double MET) const {
+	double fracSec;
+	const long long seconds = fromMET(conv, MET, fracSec);
+	return static_cast<double>(seconds) + fracSec;
+}
+
+void TimeScale::fromTM(const smart_tm* times, const size_t n, long long* secondsOut, double* fracSecsOut) const {
+	if (which == UTC) {
+		for (size_t i = 0; i < n; ++i) secondsOut[i] = fromTM(times[i], fracSecsOut[i]);
+		return;
+	}
+
+	size_t leapHint = 0;
+	double fracSec;
+	for (size_t i = 0; i < n; ++i) {
+		const long long sinceEpoch = static_cast<long long>(times[i].toEpoch(fracSec, leapHint, *context));
+		secondsOut[i] = fromEpoch(sinceEpoch, fracSec, fracSecsOut[i]);
+	}
+}
+
+void TimeScale::fromTM(const smart_tm* times, const size_t n, double* secondsOut) const {
+	size_t leapHint = 0;
+	double fracSec, scaleFracSec;
+	for (size_t i = 0; i < n; ++i) {
+		long long seconds;
+		if (which == UTC) {
+			seconds = fromTM(times[i], scaleFracSec);
+		}
+		else {
+			const long long sinceEpoch = static_cast<long long>(times[i].toEpoch(fracSec, leapHint, *context));
+			seconds = fromEpoch(sinceEpoch, fracSec, scaleFracSec);
+		}
+		secondsOut[i] = static_cast<double>(seconds) + scaleFracSec;
+	}
+}
+
+void TimeScale::toTM(const long long* seconds, const double* fracSecs, const size_t n, smart_tm* timesOut) const {
+	size_t leapHint = 0;
+	double fracSec;
+	for (size_t i = 0; i < n; ++i) {
+		const long long sinceEpoch = toEpoch(seconds[i], fracSecs[i], fracSec);
+		timesOut[i] = smart_tm(static_cast<size_t>(sinceEpoch), fracSec, leapHint, *context);
+	}
+}
+
+void TimeScale::toTM(const double* seconds, const size_t n, smart_tm* timesOut) const {
+	size_t leapHint = 0;
+	double fracSec;
+	for (size_t i = 0; i < n; ++i) {
+		const long long whole = split(seconds[i], fracSec);
+		const long long sinceEpoch = toEpoch(whole, fracSec, fracSec);
+		timesOut[i] = smart_tm(static_cast<size_t>(sinceEpoch), fracSec, leapHint, *context);
+	}
+}
+
+void TimeScale::convert(const long long* seconds, const double* fracSecs, const size_t n, const TimeScale& to, long long* secondsOut, double* fracSecsOut) const {
+	for (size_t i = 0; i < n; ++i) secondsOut[i] = convert(seconds[i], fracSecs[i], to, fracSecsOut[i]);
+}
+
+void TimeScale::convert(const double* seconds, const size_t n, const TimeScale& to, double* secondsOut) const {
+	for (size_t i = 0; i < n; ++i) secondsOut[i] = convert(seconds[i], to);
+}
+
+void TimeScale::toMET(const TimeConverter& conv, const long long* seconds, const double* fracSecs, const size_t n, double* METsOut) const {
+	for (size_t i = 0; i < n; ++i) METsOut[i] = toMET(conv, seconds[i], fracSecs[i]);
+}
+
+void TimeScale::fromMET(const TimeConverter& conv, const double* METs, const size_t n, long long* secondsOut, double* fracSecsOut) const {
+	for (size_t i = 0; i < n; ++i) secondsOut[i] = fromMET(conv, METs[i], fracSecsOut[i]);
+}
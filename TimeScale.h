@@ -0,0 +1,138 @@
+/*******************************************************************
+*   TimeScale.h
+*	UTC, TAI, GPS and TT time scales on the leap-aware epoch count
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// smart_tm's toEpoch() counts every SI second since epoch, leap seconds
+// included, so it runs in lockstep with TAI and differs from it, and from
+// GPS time and TT, only by a constant fixed by the epoch and the number
+// of leap seconds before it. Converting between those scales and the
+// epoch count is therefore one addition; only UTC, counted as Unix time
+// (which skips leap seconds), needs a leap table lookup, and UTC as a
+// smart_tm never needs one at all on the way in.
+//
+// Each scale counts seconds from its customary origin:
+//	UTC	Unix time, from 1970-01-01 00:00:00 UTC, ignoring leap seconds;
+//		a leap second reads as the first second of the next minute
+//	TAI	from 1958-01-01 00:00:00 TAI
+//	GPS	from 1980-01-06 00:00:00 UTC, the start of GPS week 0
+//	TT	from J2000.0, 2000-01-01 12:00:00 TT
+//
+// Times are whole seconds (rounded down) and a fraction in [0, 1), as
+// in TimeConverter; the double overloads are for convenience and lose
+// precision below about a microsecond.
+//
+// TAI - UTC is taken as 10 s at the leap file's first entry, 1972-01-01,
+// plus 1 s per entry after it, per the IERS file. Before 1972, when UTC
+// had no leap seconds and TAI - UTC drifted fractionally, it is held at
+// the 9 s implied by smart_tm's epoch count, so TAI, GPS and TT values
+// before then are approximate.
+//
+// Example:
+/*
+
+// with the shipped leap-seconds.list, which ends at the 2015-07-01 leap
+// second; a file with the 2017-01-01 leap second gives 1167264018
+smart_tm::init(1990, "leap-seconds.list");
+const TimeScale gps(TimeScale::GPS), tt(TimeScale::TT);
+
+double fracSec;
+const long long gpsSec = gps.fromTM(smart_tm(2017, 1, 1, 0, 0, 0, 0.0), fracSec);	// 1167264017
+const long long ttSec = gps.convert(gpsSec, fracSec, tt, fracSec);
+
+// by MET, without going through calendar fields
+TimeConverter conv(launch);
+const double MET = gps.toMET(conv, gpsSec, fracSec);
+
+*/
+
+#ifndef TIME_SCALE_H
+#define TIME_SCALE_H
+
+#include "UTC_MET.h"
+#include "smart_tm.h"
+
+// TAI - UTC before the leap file's first entry, which brings it to 10 s
+#define TAI_MINUS_UTC_BEFORE_LEAPS	(9)
+#define TAI_MINUS_GPS_SECONDS		(19)
+
+// TT - TAI is 32.184 s
+#define TT_MINUS_TAI_SECONDS		(32)
+#define TT_MINUS_TAI_FRAC_SEC		(0.184)
+
+#define TAI_ORIGIN_YR				(1958)
+#define GPS_ORIGIN_YR				(1980)
+#define GPS_ORIGIN_MON				(1)
+#define GPS_ORIGIN_DAY				(6)
+#define J2000_YR					(2000)
+#define J2000_SECONDS_INTO_DAY		(43200)
+
+class TimeScale {
+public:
+	enum Scale {
+		UTC,
+		TAI,
+		GPS,
+		TT,
+		ScaleCount
+	};
+
+	// Conversions use the given context, held for the lifetime of the
+	// scale (which must not be null); by default, the default context
+	// at construction
+	explicit TimeScale(const Scale scale, const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault());
+
+	Scale scale() const { return which; }
+	static const char* name(const Scale scale);
+
+	// Time on this scale of leap-aware seconds since epoch, and back
+	long long fromEpoch(const long long sinceEpoch, const double fracSec, double& fracSecOut) const;
+	long long toEpoch(const long long seconds, const double fracSec, double& fracSecOut) const;
+
+	// Time on this scale of a UTC smart_tm, which must be valid, and back
+	long long fromTM(const smart_tm& time, double& fracSecOut) const;
+	double fromTM(const smart_tm& time) const;
+	smart_tm toTM(const long long seconds, const double fracSec) const;
+	smart_tm toTM(const double seconds) const;
+
+	// The same time on another scale, which must share this one's context
+	long long convert(const long long seconds, const double fracSec, const TimeScale& to, double& fracSecOut) const;
+	double convert(const double seconds, const TimeScale& to) const;
+
+	// MET of conv's mission, whose context must be this one's, and back;
+	// only UTC involves any leap seconds
+	double toMET(const TimeConverter& conv, const long long seconds, const double fracSec) const;
+	double toMET(const TimeConverter& conv, const double seconds) const;
+	long long fromMET(const TimeConverter& conv, const double MET, double& fracSecOut) const;
+	double fromMET(const TimeConverter& conv, const double MET) const;
+
+	// Batch conversions of n values at a time, matching the single-value
+	// calls above element for element. Calendar conversions carry the
+	// leap second lookup from each element to the next, as in TimeConverter.
+	void fromTM(const smart_tm* times, const size_t n, long long* secondsOut, double* fracSecsOut) const;
+	void fromTM(const smart_tm* times, const size_t n, double* secondsOut) const;
+	void toTM(const long long* seconds, const double* fracSecs, const size_t n, smart_tm* timesOut) const;
+	void toTM(const double* seconds, const size_t n, smart_tm* timesOut) const;
+	void convert(const long long* seconds, const double* fracSecs, const size_t n, const TimeScale& to, long long* secondsOut, double* fracSecsOut) const;
+	void convert(const double* seconds, const size_t n, const TimeScale& to, double* secondsOut) const;
+	void toMET(const TimeConverter& conv, const long long* seconds, const double* fracSecs, const size_t n, double* METsOut) const;
+	void fromMET(const TimeConverter& conv, const double* METs, const size_t n, long long* secondsOut, double* fracSecsOut) const;
+
+private:
+	// split seconds into whole seconds (rounded down) and a fraction
+	static long long split(const double seconds, double& fracSecOut);
+
+	std::shared_ptr<const TimeContext> context;
+	Scale which;
+
+	// for all but UTC, this scale's reading at epoch
+	long long offset;
+	double fracOffset;
+};
+
+#endif
@@ -0,0 +1,144 @@
+/*******************************************************************
+*   TimeStats.cpp
+*	Optional hot-path instrumentation counters
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include <mutex>
+#include <vector>
+
+#include "TimeStats.h"
+
+namespace {
+	struct Registry {
+		std::mutex lock;
+
+		// counters of running threads
+		std::vector<const TimeStats::ThreadCounters*> live;
+
+		// sums of exited threads' counters
+		TimeStats::Snapshot retired;
+
+		// totals at the last reset(), subtracted from every snapshot
+		TimeStats::Snapshot baseline;
+	};
+
+	// never destroyed, so threads exiting during static destruction
+	// can still fold their counters in
+	Registry& registry() {
+		static Registry* const state = new Registry;
+		return *state;
+	}
+
+	void accumulate(TimeStats::Snapshot& sum, const TimeStats::ThreadCounters& counters) {
+		for (size_t i = 0; i < TimeStats::CounterCount; ++i) sum.counts[i] += counters.counts[i].load(std::memory_order_relaxed);
+		for (size_t i = 0; i < TIME_STATS_LATENCY_BUCKETS; ++i) sum.adjustLatency[i] += counters.adjustLatency[i].load(std::memory_order_relaxed);
+	}
+
+	// every thread's counts so far, without the baseline; registry lock held
+	TimeStats::Snapshot totals(Registry& state) {
+		TimeStats::Snapshot sum = state.retired;
+		for (const TimeStats::ThreadCounters* counters : state.live) accumulate(sum, *counters);
+		return sum;
+	}
+}
+
+TimeStats::Snapshot::Snapshot() {
+	for (size_t i = 0; i < CounterCount; ++i) counts[i] = 0;
+	for (size_t i = 0; i < TIME_STATS_LATENCY_BUCKETS; ++i) adjustLatency[i] = 0;
+}
+
+TimeStats::ThreadHandle::ThreadHandle() {
+	for (size_t i = 0; i < CounterCount; ++i) counters.counts[i].store(0, std::memory_order_relaxed);
+	for (size_t i = 0; i < TIME_STATS_LATENCY_BUCKETS; ++i) counters.adjustLatency[i].store(0, std::memory_order_relaxed);
+
+	Registry& state = registry();
+	std::lock_guard<std::mutex> guard(state.lock);
+	state.live.push_back(&counters);
+}
+
+TimeStats::ThreadHandle::~ThreadHandle() {
+	Registry& state = registry();
+	std::lock_guard<std::mutex> guard(state.lock);
+	accumulate(state.retired, counters);
+	for (size_t i = 0; i < state.live.size(); ++i) {
+		if (state.live[i] == &counters) {
+			state.live[i] = state.live.back();
+			state.live.pop_back();
+			break;
+		}
+	}
+}
+
+bool TimeStats::enabled() {
+#ifdef SMART_TIME_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool TimeStats::latencyEnabled() {
+#ifdef SMART_TIME_STATS_LATENCY
+	return true;
+#else
+	return false;
+#endif
+}
+
+TimeStats::Snapshot TimeStats::snapshot() {
+	Registry& state = registry();
+	std::lock_guard<std::mutex> guard(state.lock);
+	Snapshot sum = totals(state);
+	for (size_t i = 0; i < CounterCount; ++i) sum.counts[i] -= state.baseline.counts[i];
+	for (size_t i = 0; i < TIME_STATS_LATENCY_BUCKETS; ++i) sum.adjustLatency[i] -= state.baseline.adjustLatency[i];
+	return sum;
+}
+
+void TimeStats::reset() {
+	// counters are only ever written by their own threads,
+	// so rather than zeroing them, remember where they stand
+	Registry& state = registry();
+	std::lock_guard<std::mutex> guard(state.lock);
+	state.baseline = totals(state);
+}
+
+const char* TimeStats::name(const Counter counter) {
+	static const char* const names[CounterCount] = {
+		"adjust calls",
+		"adjust slow paths",
+		"leap lookups",
+		"leap hint hits",
+		"leap minute searches",
+		"checkInit warnings"
+	};
+	return (counter >= 0 && counter < CounterCount) ? names[counter] : "";
+}
+
+void TimeStats::print(std::ostream& os) {
+	if (!enabled()) {
+		os << "TimeStats: not compiled in (define SMART_TIME_STATS)" << std::endl;
+		return;
+	}
+
+	const Snapshot stats = snapshot();
+	for (size_t i = 0; i < CounterCount; ++i) {
+		os << name(static_cast<Counter>(i)) << ": " << stats.counts[i] << std::endl;
+	}
+
+	if (!latencyEnabled()) return;
+	os << "adjust slow path latency:" << std::endl;
+	for (size_t i = 0; i < TIME_STATS_LATENCY_BUCKETS; ++i) {
+		if (stats.adjustLatency[i]) os << "  " << (1ULL << i) << "-" << ((1ULL << (i + 1)) - 1) << " ns: " << stats.adjustLatency[i] << std::endl;
+	}
+}
+
+void TimeStats::addLatency(const uint64_t ns) {
+	size_t bucket = 0;
+	while (bucket + 1 < TIME_STATS_LATENCY_BUCKETS && (ns >> (bucket + 1))) ++bucket;
+	bump(local().adjustLatency[bucket], 1);
+}
@@ -0,0 +1,150 @@
+/*******************************************************************
+*   TimeStats.h
+*	Optional hot-path instrumentation counters
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// Counts what the hot paths actually do: how often adjust() has to
+// normalize rather than returning early, how often the leap table is
+// searched and how often the leap hint saves the search, and how often
+// checkInit() warns. Optionally also keeps a histogram of adjust()
+// slow-path latency.
+//
+// Compiled out unless the whole build defines SMART_TIME_STATS (and
+// SMART_TIME_STATS_LATENCY for the histogram, which reads the clock
+// twice per slow path); otherwise the instrumentation macros expand
+// to nothing and cost nothing.
+//
+// Compiled in, each thread counts into its own block of counters with
+// plain relaxed atomic loads and stores, so there are no locked
+// instructions or shared cache lines on the hot paths. snapshot() sums
+// every thread's counters, including those of threads that have exited.
+//
+// Example:
+/*
+
+g++ -O2 -DSMART_TIME_STATS ... smart_tm.cpp TimeContext.cpp TimeStats.cpp
+
+TimeStats::reset();
+runConversions();
+TimeStats::print(std::cerr);
+
+const TimeStats::Snapshot stats = TimeStats::snapshot();
+if (stats.counts[TimeStats::AdjustSlowPaths] > ...) ...
+
+*/
+
+#ifndef TIME_STATS_H
+#define TIME_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+// adjust() latency buckets: bucket i counts slow paths taking [2^i, 2^(i + 1)) ns
+#define TIME_STATS_LATENCY_BUCKETS	(32)
+
+#ifdef SMART_TIME_STATS_LATENCY
+#ifndef SMART_TIME_STATS
+#define SMART_TIME_STATS
+#endif
+#endif
+
+class TimeStats {
+public:
+	enum Counter {
+		AdjustCalls,				// adjust() calls
+		AdjustSlowPaths,			// adjust() calls that had to normalize
+		LeapLookups,				// leap table position lookups
+		LeapHintHits,				// ...of which answered by the leap hint
+		LeapMinuteSearches,			// isLeapMinute() calls needing a search
+		CheckInitWarnings,			// checkInit() warnings printed
+		CounterCount
+	};
+
+	struct Snapshot {
+		uint64_t counts[CounterCount];
+		uint64_t adjustLatency[TIME_STATS_LATENCY_BUCKETS];
+
+		Snapshot();
+	};
+
+	// Whether the counters and the latency histogram are compiled in
+	static bool enabled();
+	static bool latencyEnabled();
+
+	// Totals over all threads since the last reset()
+	static Snapshot snapshot();
+
+	// Start counting again from zero
+	static void reset();
+
+	static const char* name(const Counter counter);
+
+	// Write every counter, and any nonempty latency buckets
+	static void print(std::ostream& os);
+
+	// For the instrumentation macros below
+
+	static inline void add(const Counter counter, const uint64_t n) {
+		bump(local().counts[counter], n);
+	}
+
+	static void addLatency(const uint64_t ns);
+
+	class LatencyTimer {
+	public:
+		LatencyTimer() : start(std::chrono::steady_clock::now()) {}
+		~LatencyTimer() {
+			addLatency(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+		}
+
+	private:
+		const std::chrono::steady_clock::time_point start;
+	};
+
+	struct ThreadCounters {
+		std::atomic<uint64_t> counts[CounterCount];
+		std::atomic<uint64_t> adjustLatency[TIME_STATS_LATENCY_BUCKETS];
+	};
+
+private:
+	// registers the calling thread's counters on creation,
+	// and folds them into the totals of exited threads on destruction
+	struct ThreadHandle {
+		ThreadHandle();
+		~ThreadHandle();
+		ThreadCounters counters;
+	};
+
+	static inline ThreadCounters& local() {
+		thread_local ThreadHandle handle;
+		return handle.counters;
+	}
+
+	// only the owning thread writes its counters, so no read-modify-write is needed
+	static inline void bump(std::atomic<uint64_t>& counter, const uint64_t n) {
+		counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+};
+
+#ifdef SMART_TIME_STATS
+#define TIME_STATS_COUNT(counter)		TimeStats::add(TimeStats::counter, 1)
+#define TIME_STATS_ADD(counter, n)		TimeStats::add(TimeStats::counter, (n))
+#else
+#define TIME_STATS_COUNT(counter)		((void)0)
+#define TIME_STATS_ADD(counter, n)		((void)0)
+#endif
+
+#ifdef SMART_TIME_STATS_LATENCY
+#define TIME_STATS_TIME_ADJUST()		const TimeStats::LatencyTimer adjustLatencyTimer
+#else
+#define TIME_STATS_TIME_ADJUST()		((void)0)
+#endif
+
+#endif
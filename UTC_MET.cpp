@@ -84,46 +84,276 @@ std::cout << myTime << std::endl;
 */
 
 #include "UTC_MET.h"
+#include "CivilSIMD.h"
 
-TimeConverter::TimeConverter(const size_t sinceEpoch, const double sinceEpochFracSec) {
+TimeConverter::TimeConverter(const size_t sinceEpoch, const double sinceEpochFracSec, const std::shared_ptr<const TimeContext>& context /* =TimeContext::sharedDefault() */)
+	: context(context), missionStartTM(*context) {
 	missionStartEpoch = sinceEpoch;
 	missionStartEpochFracSec = sinceEpochFracSec;
-	missionStartTM = smart_tm(sinceEpoch, sinceEpochFracSec);
+	missionStartTM = smart_tm(sinceEpoch, sinceEpochFracSec, *context);
+	precompute();
 }
 
-TimeConverter::TimeConverter(const smart_tm& missionStartTM) {
-	this->missionStartTM = missionStartTM;
-	missionStartEpoch = missionStartTM.toEpoch(missionStartEpochFracSec);
+TimeConverter::TimeConverter(const smart_tm& missionStartTM, const std::shared_ptr<const TimeContext>& context /* =TimeContext::sharedDefault() */)
+	: context(context), missionStartTM(missionStartTM) {
+	missionStartEpoch = missionStartTM.toEpoch(missionStartEpochFracSec, *context);
+	precompute();
+}
+
+void TimeConverter::precompute() {
+	utcStartEpoch = static_cast<long long>(missionStartTM.toEpoch(utcStartFracSec, *context));
+
+	// every leap second from the mission start on, including one
+	// the mission starts in; epoch time of leap second j, less j,
+	// is the nonleap time of the moment after it
+	const std::vector<size_t>& leapSeconds = context->leapSecondEpochs();
+	const long long epochNonleap = daysFromCivil(context->epochYear(), START_MON, START_DAY) * SECONDS_PER_DAY;
+	const long long before = std::lower_bound(leapSeconds.begin(), leapSeconds.end(), utcStartEpoch,
+		[](const size_t leapSecond, const long long time) { return static_cast<long long>(leapSecond) < time; }) - leapSeconds.begin();
+	for (size_t j = static_cast<size_t>(before); j < leapSeconds.size(); ++j) {
+		leapMETs.push_back(static_cast<long long>(leapSeconds[j]) - utcStartEpoch);
+		leapNonleaps.push_back(static_cast<long long>(leapSeconds[j]) - static_cast<long long>(j) + epochNonleap);
+	}
+
+	metOffset = before - epochNonleap - static_cast<long long>(missionStartEpoch);
+	utcOffset = utcStartEpoch - before + epochNonleap;
+}
+
+long long TimeConverter::nonleapSince(const smart_tm& time) {
+	return daysFromCivil(time.yr, time.mon, time.day) * SECONDS_PER_DAY + (time.hr - START_HR) * SECONDS_PER_HOUR +
+		(time.min - START_MIN) * TYPICAL_SECONDS_PER_MINUTE + (time.sec - START_SEC);
+}
+
+long long TimeConverter::wholeMET(const smart_tm& time) const {
+	const long long nonleap = nonleapSince(time);
+
+	// leap seconds walked through: all of them, for any time after the last
+	size_t walked = leapNonleaps.size();
+	if (walked && leapNonleaps.back() > nonleap) {
+		walked = std::upper_bound(leapNonleaps.begin(), leapNonleaps.end(), nonleap) - leapNonleaps.begin();
+	}
+
+	// a leap second ('60') has the same nonleap count as the first second
+	// of the following minute, but has not yet walked through itself
+	if (walked && leapNonleaps[walked - 1] == nonleap && time.sec - START_SEC >= TYPICAL_SECONDS_PER_MINUTE) --walked;
+
+	return nonleap + metOffset + static_cast<long long>(walked);
 }
 
 double TimeConverter::toMET(const smart_tm& time) const {
-	double fracSec;
-	size_t wholeSec = time.toEpoch(fracSec) - missionStartEpoch;
-	return static_cast<double>(wholeSec) + (fracSec - missionStartEpochFracSec);
+	return static_cast<double>(static_cast<size_t>(wholeMET(time))) + (time.fracSec - missionStartEpochFracSec);
 }
 
 size_t TimeConverter::toMET(const smart_tm& time, double& fracSecOut) const {
-	size_t wholeSec = time.toEpoch(fracSecOut) - missionStartEpoch;
-	fracSecOut -= missionStartEpochFracSec;
-	return wholeSec;
+	fracSecOut = time.fracSec - missionStartEpochFracSec;
+	return static_cast<size_t>(wholeMET(time));
 }
 
 size_t TimeConverter::toIntegralMET(const smart_tm& time) const {
-	return time.toEpoch() - missionStartEpoch;
+	return static_cast<size_t>(wholeMET(time));
 }
 
 smart_tm TimeConverter::toUTC(const double MET) const {
-	smart_tm ret = missionStartTM;
-	ret.sec += static_cast<size_t>(MET);
-	ret.fracSec += (MET - floor(MET));
-	ret.adjust();
-	return ret;
+	return toUTC(static_cast<size_t>(MET), MET - floor(MET));
 }
 
 smart_tm TimeConverter::toUTC(const size_t wholeMET, const double fracMET) const {
-	smart_tm ret = missionStartTM;
-	ret.sec += wholeMET;
-	ret.fracSec += fracMET;
-	ret.adjust();
-	return ret;
-}
\ No newline at end of file
+	// carry whole seconds out of the fraction, as the smart_tm constructors do
+	double fracSec = utcStartFracSec + fracMET;
+	long long MET = static_cast<long long>(wholeMET);
+	if (fracSec < START_FRAC_SEC || fracSec >= END_FRAC_SEC) {
+		const long long count = static_cast<long long>(floor(fracSec - START_FRAC_SEC));
+		fracSec -= static_cast<double>(count);
+		MET += count;
+	}
+
+	// leap seconds strictly before this MET, and whether it is one
+	size_t before = leapMETs.size();
+	if (before && leapMETs.back() >= MET) {
+		before = std::lower_bound(leapMETs.begin(), leapMETs.end(), MET) - leapMETs.begin();
+	}
+	const bool onLeapSecond = before < leapMETs.size() && leapMETs[before] == MET;
+
+	// floor division, so days before daysFromCivil()'s day 0 come out right
+	const long long nonleap = MET + utcOffset - static_cast<long long>(before) - (onLeapSecond ? 1 : 0);
+	long long dayCount = nonleap / SECONDS_PER_DAY;
+	long long secOfDay = nonleap % SECONDS_PER_DAY;
+	if (secOfDay < 0) {
+		secOfDay += SECONDS_PER_DAY;
+		--dayCount;
+	}
+
+	long long yr, mon, day;
+	civilFromDays(dayCount, yr, mon, day);
+	return smart_tm(yr, mon, day, secOfDay / SECONDS_PER_HOUR + START_HR, (secOfDay % SECONDS_PER_HOUR) / TYPICAL_SECONDS_PER_MINUTE + START_MIN,
+		secOfDay % TYPICAL_SECONDS_PER_MINUTE + START_SEC + (onLeapSecond ? 1 : 0), fracSec);
+}
+
+void TimeConverter::toMET(const smart_tm* times, const size_t n, double* METsOut) const {
+	size_t leapHint = 0;
+	double fracSec;
+	for (size_t i = 0; i < n; ++i) {
+		size_t wholeSec = times[i].toEpoch(fracSec, leapHint, *context) - missionStartEpoch;
+		METsOut[i] = static_cast<double>(wholeSec) + (fracSec - missionStartEpochFracSec);
+	}
+}
+
+void TimeConverter::toMET(const smart_tm* times, const size_t n, size_t* wholeMETsOut, double* fracMETsOut) const {
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		wholeMETsOut[i] = times[i].toEpoch(fracMETsOut[i], leapHint, *context) - missionStartEpoch;
+		fracMETsOut[i] -= missionStartEpochFracSec;
+	}
+}
+
+void TimeConverter::toIntegralMET(const smart_tm* times, const size_t n, size_t* METsOut) const {
+	size_t leapHint = 0;
+	double fracSec;
+	for (size_t i = 0; i < n; ++i) {
+		METsOut[i] = times[i].toEpoch(fracSec, leapHint, *context) - missionStartEpoch;
+	}
+}
+
+// The single-value toUTC() calls count leap seconds against the
+// precomputed leapMETs and decompose the day count directly. The batch
+// calls instead place each MET, offset by the mission start's own epoch
+// time, as a time since epoch; both give the same fields for every MET.
+
+void TimeConverter::toUTC(const double* METs, const size_t n, smart_tm* timesOut) const {
+	const size_t startEpoch = static_cast<size_t>(utcStartEpoch);
+	const double startFracSec = utcStartFracSec;
+
+	if (civilSIMDAvailable()) {
+		// decompose a chunk at a time into columns, then gather into smart_tms
+		long long yr[BATCH_CHUNK], mon[BATCH_CHUNK], day[BATCH_CHUNK], hr[BATCH_CHUNK], min[BATCH_CHUNK], sec[BATCH_CHUNK];
+		double fracSec[BATCH_CHUNK];
+		const UTCColumns chunk = { yr, mon, day, hr, min, sec, fracSec };
+		for (size_t i = 0; i < n; i += BATCH_CHUNK) {
+			const size_t count = std::min(static_cast<size_t>(BATCH_CHUNK), n - i);
+			civilFromMETsSIMD(METs + i, count, startEpoch, startFracSec, chunk, *context);
+			for (size_t j = 0; j < count; ++j) {
+				timesOut[i + j] = smart_tm(yr[j], mon[j], day[j], hr[j], min[j], sec[j], fracSec[j]);
+			}
+		}
+		return;
+	}
+
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		timesOut[i] = smart_tm(startEpoch + static_cast<size_t>(METs[i]), startFracSec + (METs[i] - floor(METs[i])), leapHint, *context);
+	}
+}
+
+void TimeConverter::toUTC(const size_t* wholeMETs, const double* fracMETs, const size_t n, smart_tm* timesOut) const {
+	const size_t startEpoch = static_cast<size_t>(utcStartEpoch);
+	const double startFracSec = utcStartFracSec;
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		timesOut[i] = smart_tm(startEpoch + wholeMETs[i], startFracSec + fracMETs[i], leapHint, *context);
+	}
+}
+
+static inline void storeColumns(const smart_tm& time, const size_t i, const UTCColumns& columns) {
+	if (columns.yr) columns.yr[i] = time.yr;
+	if (columns.mon) columns.mon[i] = time.mon;
+	if (columns.day) columns.day[i] = time.day;
+	if (columns.hr) columns.hr[i] = time.hr;
+	if (columns.min) columns.min[i] = time.min;
+	if (columns.sec) columns.sec[i] = time.sec;
+	if (columns.fracSec) columns.fracSec[i] = time.fracSec;
+}
+
+void TimeConverter::toUTC(const double* METs, const size_t n, const UTCColumns& timesOut) const {
+	const size_t startEpoch = static_cast<size_t>(utcStartEpoch);
+	const double startFracSec = utcStartFracSec;
+	if (civilFromMETsSIMD(METs, n, startEpoch, startFracSec, timesOut, *context)) return;
+
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		storeColumns(smart_tm(startEpoch + static_cast<size_t>(METs[i]), startFracSec + (METs[i] - floor(METs[i])), leapHint, *context), i, timesOut);
+	}
+}
+
+void TimeConverter::toUTC(const size_t* wholeMETs, const double* fracMETs, const size_t n, const UTCColumns& timesOut) const {
+	const size_t startEpoch = static_cast<size_t>(utcStartEpoch);
+	const double startFracSec = utcStartFracSec;
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		storeColumns(smart_tm(startEpoch + wholeMETs[i], startFracSec + fracMETs[i], leapHint, *context), i, timesOut);
+	}
+}
+
+UTCCursor::UTCCursor(const TimeConverter& conv)
+	: context(conv.context), current(*conv.context), leapHint(0), minuteStart(0), minuteEnd(0), dayStart(0), dayEnd(0) {
+	// same mission start as toUTC()
+	startEpoch = static_cast<size_t>(conv.utcStartEpoch);
+	startFracSec = conv.utcStartFracSec;
+}
+
+const smart_tm& UTCCursor::toUTC(const double MET) {
+	seek(static_cast<long long>(startEpoch + static_cast<size_t>(MET)), startFracSec + (MET - floor(MET)));
+	return current;
+}
+
+const smart_tm& UTCCursor::toUTC(const size_t wholeMET, const double fracMET) {
+	seek(static_cast<long long>(startEpoch + wholeMET), startFracSec + fracMET);
+	return current;
+}
+
+void UTCCursor::seek(long long sinceEpoch, double fracSec) {
+	// carry whole seconds out of fracSec, as the smart_tm constructors do
+	if (fracSec < START_FRAC_SEC || fracSec >= END_FRAC_SEC) {
+		const long long count = static_cast<long long>(floor(fracSec - START_FRAC_SEC));
+		fracSec -= static_cast<double>(count);
+		sinceEpoch += count;
+	}
+
+	// same minute: only the second changes...
+	if (sinceEpoch >= minuteStart && sinceEpoch < minuteEnd) {
+		current.sec = START_SEC + (sinceEpoch - minuteStart);
+		current.fracSec = fracSec;
+		return;
+	}
+
+	// ...same day: only the time of day...
+	if (sinceEpoch >= dayStart && sinceEpoch < dayEnd) {
+		const long long secOfDay = sinceEpoch - dayStart;
+
+		// the leap second, if the day has one, is its last second
+		if (secOfDay >= SECONDS_PER_DAY) {
+			current.hr = END_HR;
+			current.min = END_MIN;
+			current.sec = START_SEC + TYPICAL_SECONDS_PER_MINUTE;
+			minuteStart = dayStart + SECONDS_PER_DAY - TYPICAL_SECONDS_PER_MINUTE;
+		}
+		else {
+			current.hr = START_HR + secOfDay / SECONDS_PER_HOUR;
+			current.min = START_MIN + (secOfDay % SECONDS_PER_HOUR) / TYPICAL_SECONDS_PER_MINUTE;
+			current.sec = START_SEC + secOfDay % TYPICAL_SECONDS_PER_MINUTE;
+			minuteStart = sinceEpoch - (current.sec - START_SEC);
+		}
+		minuteEnd = std::min(minuteStart + TYPICAL_SECONDS_PER_MINUTE, dayEnd);
+		if (minuteEnd == dayEnd - 1) ++minuteEnd;
+		current.fracSec = fracSec;
+		return;
+	}
+
+	// ...otherwise start over
+	recompute(sinceEpoch, fracSec);
+}
+
+void UTCCursor::recompute(const long long sinceEpoch, const double fracSec) {
+	current = smart_tm(static_cast<size_t>(sinceEpoch), fracSec, leapHint, *context);
+
+	// leapHint now counts the leap seconds before sinceEpoch, so it indexes
+	// this day's leap second, which would be its last second, if it has one
+	const long long secOfDay = (current.hr - START_HR) * SECONDS_PER_HOUR + (current.min - START_MIN) * TYPICAL_SECONDS_PER_MINUTE + (current.sec - START_SEC);
+	const std::vector<size_t>& leapSeconds = context->leapSecondEpochs();
+	dayStart = sinceEpoch - secOfDay;
+	const bool endsInLeapSecond = leapHint < leapSeconds.size() && static_cast<long long>(leapSeconds[leapHint]) == dayStart + SECONDS_PER_DAY;
+	dayEnd = dayStart + SECONDS_PER_DAY + (endsInLeapSecond ? 1 : 0);
+
+	minuteStart = sinceEpoch - (current.sec - START_SEC);
+	minuteEnd = minuteStart + TYPICAL_SECONDS_PER_MINUTE;
+	if (minuteEnd == dayEnd - 1) ++minuteEnd;
+}
@@ -88,10 +88,35 @@ std::cout << myTime << std::endl;
 
 #include "smart_tm.h"
 
+// METs decomposed per chunk by the vectorized batch toUTC()
+#define BATCH_CHUNK					(256)
+
+// Structure-of-arrays destination for batch UTC output,
+// one column per smart_tm field. Any column may be nullptr
+// to skip writing that field.
+struct UTCColumns {
+	long long*	yr;
+	long long*	mon;
+	long long*	day;
+	long long*	hr;
+	long long*	min;
+	long long*	sec;
+	double*		fracSec;
+};
+
+// At construction, a converter works out the MET of every leap second
+// after its mission start, so that its single-value toMET() and toUTC()
+// calls need only a binary search of those (usually few, often no)
+// METs plus integer arithmetic, rather than adjust() from the mission
+// start or a search of the context's whole leap table. Results are the
+// same; times are expected at or after the mission start.
 class TimeConverter {
 public:
-	TimeConverter(const size_t sinceEpoch, const double sinceEpochFracSec);
-	TimeConverter(const smart_tm& missionStartTM);
+	// Every conversion uses the given context, held for the lifetime
+	// of the converter (which must not be null); by default,
+	// the default context at construction
+	TimeConverter(const size_t sinceEpoch, const double sinceEpochFracSec, const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault());
+	TimeConverter(const smart_tm& missionStartTM, const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault());
 
 	double toMET(const smart_tm& time) const;
 	size_t toMET(const smart_tm& time, double& fracSecOut) const;
@@ -99,10 +124,109 @@ public:
 	smart_tm toUTC(const double MET) const;
 	smart_tm toUTC(const size_t wholeMET, const double fracMET) const;
 
+	// Batch conversions of n values at a time. Results match the
+	// single-value calls above element for element. The leap second
+	// lookup is carried from each element to the next, so sorted and
+	// nearly-sorted input skips it almost entirely.
+	void toMET(const smart_tm* times, const size_t n, double* METsOut) const;
+	void toMET(const smart_tm* times, const size_t n, size_t* wholeMETsOut, double* fracMETsOut) const;
+	void toIntegralMET(const smart_tm* times, const size_t n, size_t* METsOut) const;
+	void toUTC(const double* METs, const size_t n, smart_tm* timesOut) const;
+	void toUTC(const size_t* wholeMETs, const double* fracMETs, const size_t n, smart_tm* timesOut) const;
+	void toUTC(const double* METs, const size_t n, const UTCColumns& timesOut) const;
+	void toUTC(const size_t* wholeMETs, const double* fracMETs, const size_t n, const UTCColumns& timesOut) const;
+
+	// Mission start (MET 0) as seconds and fractional seconds since epoch
+	size_t missionStart(double& fracSecOut) const { fracSecOut = missionStartEpochFracSec; return missionStartEpoch; }
+
+	const std::shared_ptr<const TimeContext>& timeContext() const { return context; }
+
 private:
+	// fill in the leap second METs and offsets below
+	void precompute();
+
+	// whole MET of a time, from the mission start
+	long long wholeMET(const smart_tm& time) const;
+
+	// seconds of a time since daysFromCivil()'s day 0,
+	// ignoring leap seconds (so second '60' is the next minute's first)
+	static long long nonleapSince(const smart_tm& time);
+
+	std::shared_ptr<const TimeContext> context;
 	smart_tm missionStartTM;
 	size_t missionStartEpoch;
 	double missionStartEpochFracSec;
+
+	// missionStartTM's own epoch time, from which toUTC() counts
+	long long utcStartEpoch;
+	double utcStartFracSec;
+
+	// for each leap second from utcStartEpoch on, its whole MET, and
+	// the nonleap seconds (see nonleapSince()) of the moment after it
+	std::vector<long long> leapMETs;
+	std::vector<long long> leapNonleaps;
+
+	// toMET(): MET = nonleap seconds + metOffset + leap seconds walked
+	// through since the mission start; toUTC(): the reverse
+	long long metOffset;
+	long long utcOffset;
+
+	friend class UTCCursor;
+};
+
+// Incremental MET -> UTC conversion for streams of METs that arrive in
+// (nearly) increasing order, such as telemetry packet timestamps.
+//
+// The cursor remembers the last time it produced along with the
+// epoch-second bounds of its minute and day, and whether the day ends
+// in a leap second. A MET landing in the same minute then costs a
+// compare and a subtract; one in the same day a few divisions. Only
+// METs outside the current day (in either direction) fall back to a
+// full conversion, which re-establishes the bounds.
+//
+// Results match TimeConverter::toUTC() of the same MET exactly.
+//
+// Example:
+/*
+
+TimeConverter conv(launch);
+UTCCursor cursor(conv);
+for (const Packet& packet : packets) {
+	const smart_tm& time = cursor.toUTC(packet.MET);
+	...
+}
+
+*/
+class UTCCursor {
+public:
+	// Independent of conv after construction
+	explicit UTCCursor(const TimeConverter& conv);
+
+	// Same as conv.toUTC(MET) and conv.toUTC(wholeMET, fracMET).
+	// The reference stays valid, and is overwritten by, the next call.
+	const smart_tm& toUTC(const double MET);
+	const smart_tm& toUTC(const size_t wholeMET, const double fracMET);
+
+private:
+	// set current to the time sinceEpoch (leap-aware) + fracSec
+	void seek(long long sinceEpoch, double fracSec);
+
+	// full conversion, then new minute and day bounds
+	void recompute(const long long sinceEpoch, const double fracSec);
+
+	std::shared_ptr<const TimeContext> context;
+	size_t startEpoch;
+	double startFracSec;
+
+	smart_tm current;
+	size_t leapHint;
+
+	// epoch seconds [start, end) of the current minute and day;
+	// a day ending in a leap second, and its last minute, are 1 second longer
+	long long minuteStart;
+	long long minuteEnd;
+	long long dayStart;
+	long long dayEnd;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,348 @@
+/*******************************************************************
+*   fixed_tm.h
+*	Fixed-point (integer tick) times and exact MET conversion
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// smart_tm keeps fractional seconds as a double, so normalizing them
+// takes floor() and METs held as doubles lose sub-microsecond precision
+// past ~10^9 s. fixed_tm<TicksPerSecond> is smart_tm with the fraction
+// instead held as an integer count of ticks, 0 <= ticks < TicksPerSecond,
+// at a resolution chosen at compile time (nano_tm and pico_tm below).
+//
+// Everything - normalization, toEpoch(), and MET conversion through
+// FixedTimeConverter - is integer arithmetic, and METs are exact
+// (whole seconds, ticks) pairs, fixed_met, so sums, differences and
+// round trips never drift. The whole-second work is done by smart_tm's
+// own integer paths, so results agree with smart_tm second for second.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+const FixedTimeConverter<NANOS_PER_SECOND> conv(nano_tm(2008, 6, 11, 16, 5, 0, 0));
+
+nano_met MET = conv.toMET(nano_tm(2015, 6, 30, 23, 59, 60, 999999999));
+MET.ticks += 1;
+MET.normalize();
+std::cout << conv.toUTC(MET) << std::endl;		// 2015/07/01 00:00:00.000000000
+
+*/
+
+#ifndef FIXED_TM_H
+#define FIXED_TM_H
+
+#include "smart_tm.h"
+#include "UTC_MET.h"
+
+#define NANOS_PER_SECOND			(1000000000LL)
+#define PICOS_PER_SECOND			(1000000000000LL)
+
+// largest resolution whose ticks, and a second's worth more,
+// still fit comfortably in a long long
+#define MAX_TICKS_PER_SECOND		(1000000000000000000LL)
+
+namespace fixed_detail {
+	constexpr bool isPowerOf10(const long long n) { return n == 1 || (n % 10 == 0 && isPowerOf10(n / 10)); }
+	constexpr int decimalDigits(const long long unitsPerSecond) { return (unitsPerSecond <= 1) ? 0 : 1 + decimalDigits(unitsPerSecond / 10); }
+}
+
+// An exact MET or other duration: sec seconds plus ticks / TicksPerSecond.
+// Normalized form has 0 <= ticks < TicksPerSecond, so a negative
+// duration has negative sec, e.g. -0.25 s is { -1, 0.75 s }.
+template <long long TicksPerSecond>
+struct fixed_met {
+	long long	sec;
+	long long	ticks;
+
+	fixed_met() : sec(0), ticks(0) {}
+	fixed_met(const long long sec, const long long ticks) : sec(sec), ticks(ticks) { normalize(); }
+
+	// Carry ticks outside [0, TicksPerSecond) into sec
+	void normalize() {
+		const long long carry = floorDiv(ticks, TicksPerSecond);
+		sec += carry;
+		ticks -= carry * TicksPerSecond;
+	}
+
+	// Nearest double, e.g. for TimeConverter interop; inexact past ~2^53 ticks
+	double toDouble() const { return static_cast<double>(sec) + static_cast<double>(ticks) / static_cast<double>(TicksPerSecond); }
+
+	// Nearest fixed_met to a double number of seconds
+	static fixed_met fromDouble(const double seconds) {
+		const double whole = floor(seconds);
+		return fixed_met(static_cast<long long>(whole), llround((seconds - whole) * static_cast<double>(TicksPerSecond)));
+	}
+};
+
+template <long long T> inline fixed_met<T> operator+(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return fixed_met<T>(lhs.sec + rhs.sec, lhs.ticks + rhs.ticks); }
+template <long long T> inline fixed_met<T> operator-(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return fixed_met<T>(lhs.sec - rhs.sec, lhs.ticks - rhs.ticks); }
+
+template <long long T> inline bool operator==(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return lhs.sec == rhs.sec && lhs.ticks == rhs.ticks; }
+template <long long T> inline bool operator!=(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return !(lhs == rhs); }
+template <long long T> inline bool operator<(const fixed_met<T>& lhs, const fixed_met<T>& rhs) {
+	return (lhs.sec == rhs.sec) ? (lhs.ticks < rhs.ticks) : (lhs.sec < rhs.sec);
+}
+template <long long T> inline bool operator>(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return rhs < lhs; }
+template <long long T> inline bool operator<=(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return !(lhs > rhs); }
+template <long long T> inline bool operator>=(const fixed_met<T>& lhs, const fixed_met<T>& rhs) { return !(lhs < rhs); }
+
+template <long long TicksPerSecond>
+class fixed_tm {
+	static_assert(TicksPerSecond > 0 && TicksPerSecond <= MAX_TICKS_PER_SECOND && fixed_detail::isPowerOf10(TicksPerSecond),
+		"fixed_tm resolution must be a power of 10 from 1 to 10^18 ticks per second");
+
+// Variables:
+
+public:
+	long long	yr;
+	long long	mon;
+	long long	day;
+	long long	hr;
+	long long	min;
+	long long	sec;
+	long long	ticks;
+
+	// digits after the decimal point when printed
+	static constexpr int fracDigits = fixed_detail::decimalDigits(TicksPerSecond);
+
+// Methods:
+
+public:
+
+	// Create fixed_tm set to epoch of the given context
+	explicit fixed_tm(const TimeContext& context = TimeContext::getDefault())
+		: yr(context.epochYear()), mon(START_MON), day(START_DAY), hr(START_HR), min(START_MIN), sec(START_SEC), ticks(0) {}
+
+	// Create fixed_tm from raw entry of absolute year, month, day, etc.
+	fixed_tm(const long long yr, const long long mon, const long long day, const long long hr, const long long min, const long long sec, const long long ticks)
+		: yr(yr), mon(mon), day(day), hr(hr), min(min), sec(sec), ticks(ticks) {}
+
+	// Create fixed_tm as seconds and ticks since epoch; ticks may be
+	// outside [0, TicksPerSecond), whole seconds are carried
+	fixed_tm(const size_t sinceEpoch, const long long ticks, const TimeContext& context = TimeContext::getDefault()) : fixed_tm(context) {
+		size_t leapHint = 0;
+		setFromEpoch(static_cast<long long>(sinceEpoch), ticks, leapHint, context);
+	}
+
+	// As above, reusing and updating leapHint as in smart_tm's leapHint constructor
+	fixed_tm(const size_t sinceEpoch, const long long ticks, size_t& leapHint, const TimeContext& context = TimeContext::getDefault()) : fixed_tm(context) {
+		setFromEpoch(static_cast<long long>(sinceEpoch), ticks, leapHint, context);
+	}
+
+	// Create fixed_tm from a smart_tm, rounding fracSec to the nearest tick
+	// (carrying into the seconds if it rounds to a whole second or more,
+	// or below 0)
+	explicit fixed_tm(const smart_tm& time, const TimeContext& context = TimeContext::getDefault())
+		: yr(time.yr), mon(time.mon), day(time.day), hr(time.hr), min(time.min), sec(time.sec),
+		ticks(llround(time.fracSec * static_cast<double>(TicksPerSecond))) {
+		if (ticks < 0 || ticks >= TicksPerSecond) adjust(context);
+	}
+
+	// Equivalent smart_tm; the fraction is rounded to the nearest double
+	smart_tm toTM() const {
+		return smart_tm(yr, mon, day, hr, min, sec, static_cast<double>(ticks) / static_cast<double>(TicksPerSecond));
+	}
+
+	// Is this a possible date and time?
+	bool isValid(const TimeContext& context = TimeContext::getDefault()) const {
+		return ticks >= 0 && ticks < TicksPerSecond && wholeSeconds().isValid(context);
+	}
+
+	// As smart_tm::adjust(), with the same rollover rules and the same
+	// constant time, with ticks carrying into seconds first: months
+	// carry into years, minutes into hours and hours into days as
+	// calendar fields, one floor division each; seconds then count
+	// elapsed (leap-aware) seconds from the start of the resulting minute.
+	void adjust(const TimeContext& context = TimeContext::getDefault()) {
+		long long carry = floorDiv(ticks, TicksPerSecond);
+		sec += carry;
+		ticks -= carry * TicksPerSecond;
+
+		if (wholeSeconds().isValid(context)) return;
+
+		carry = floorDiv(mon - START_MON, MONTHS_PER_YEAR);
+		yr += carry;
+		mon -= carry * MONTHS_PER_YEAR;
+
+		carry = floorDiv(min - START_MIN, MINUTES_PER_HOUR);
+		hr += carry;
+		min -= carry * MINUTES_PER_HOUR;
+
+		carry = floorDiv(hr - START_HR, HOURS_PER_DAY);
+		day += carry;
+		hr -= carry * HOURS_PER_DAY;
+
+		civilFromDays(daysFromCivil(yr, mon, START_DAY) + (day - START_DAY), yr, mon, day);
+
+		const long long elapsed = sec - START_SEC;
+		sec = START_SEC;
+		size_t leapHint = 0;
+		const long long minuteEpoch = static_cast<long long>(wholeSeconds().toEpoch(context));
+		setFromEpoch(minuteEpoch + elapsed, ticks, leapHint, context);
+	}
+
+	// Return seconds since epoch, and the ticks past that second
+	size_t toEpoch(long long& ticksOut, const TimeContext& context = TimeContext::getDefault()) const {
+		ticksOut = ticks;
+		return wholeSeconds().toEpoch(context);
+	}
+
+	// As above, reusing and updating leapHint as in smart_tm's leapHint constructor
+	size_t toEpoch(long long& ticksOut, size_t& leapHint, const TimeContext& context = TimeContext::getDefault()) const {
+		double unused;
+		ticksOut = ticks;
+		return wholeSeconds().toEpoch(unused, leapHint, context);
+	}
+
+	// Write 'YYYY/MM/DD hh:mm:ss.<fracDigits digits>' into buf, as
+	// smart_tm::format(). A cap of FORMAT_BUFFER_SIZE always fits.
+	size_t format(char* buf, const size_t cap, const char dateSeparator='/') const {
+		char text[FORMAT_BUFFER_SIZE];
+		char* out = writePadded(text, yr, 4);
+		*out++ = dateSeparator;
+		out = writePadded(out, mon, 2);
+		*out++ = dateSeparator;
+		out = writePadded(out, day, 2);
+		*out++ = ' ';
+		out = writePadded(out, hr, 2);
+		*out++ = ':';
+		out = writePadded(out, min, 2);
+		*out++ = ':';
+		out = writePadded(out, sec, 2);
+		if (fracDigits) {
+			*out++ = '.';
+			out = writePadded(out, ticks, fracDigits);
+		}
+
+		const size_t length = static_cast<size_t>(out - text);
+		if (length > cap) return 0;
+		memcpy(buf, text, length);
+		if (length < cap) buf[length] = '\0';
+		return length;
+	}
+
+	std::string toString(const char dateSeparator='/') const {
+		char text[FORMAT_BUFFER_SIZE];
+		return std::string(text, format(text, sizeof(text), dateSeparator));
+	}
+
+private:
+
+	// The whole-second part, for smart_tm's integer paths
+	smart_tm wholeSeconds() const { return smart_tm(yr, mon, day, hr, min, sec, START_FRAC_SEC); }
+
+	void setFromEpoch(long long sinceEpoch, long long ticks, size_t& leapHint, const TimeContext& context) {
+		const long long carry = floorDiv(ticks, TicksPerSecond);
+		sinceEpoch += carry;
+		this->ticks = ticks - carry * TicksPerSecond;
+
+		const smart_tm whole(static_cast<size_t>(sinceEpoch), START_FRAC_SEC, leapHint, context);
+		yr = whole.yr;
+		mon = whole.mon;
+		day = whole.day;
+		hr = whole.hr;
+		min = whole.min;
+		sec = whole.sec;
+	}
+};
+
+template <long long T> inline bool operator==(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) {
+	return lhs.yr == rhs.yr && lhs.mon == rhs.mon && lhs.day == rhs.day && lhs.hr == rhs.hr && lhs.min == rhs.min && lhs.sec == rhs.sec && lhs.ticks == rhs.ticks;
+}
+template <long long T> inline bool operator!=(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) { return !(lhs == rhs); }
+
+// Field by field, as smart_tm's operator<; both must be valid
+template <long long T> inline bool operator<(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) {
+	if (lhs.yr != rhs.yr) return lhs.yr < rhs.yr;
+	if (lhs.mon != rhs.mon) return lhs.mon < rhs.mon;
+	if (lhs.day != rhs.day) return lhs.day < rhs.day;
+	if (lhs.hr != rhs.hr) return lhs.hr < rhs.hr;
+	if (lhs.min != rhs.min) return lhs.min < rhs.min;
+	if (lhs.sec != rhs.sec) return lhs.sec < rhs.sec;
+	return lhs.ticks < rhs.ticks;
+}
+template <long long T> inline bool operator>(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) { return rhs < lhs; }
+template <long long T> inline bool operator<=(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) { return !(lhs > rhs); }
+template <long long T> inline bool operator>=(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) { return !(lhs < rhs); }
+
+// Exact elapsed time from rhs to lhs, leap seconds included
+template <long long T> inline fixed_met<T> operator-(const fixed_tm<T>& lhs, const fixed_tm<T>& rhs) {
+	long long lTicks, rTicks;
+	const long long lEpoch = static_cast<long long>(lhs.toEpoch(lTicks));
+	const long long rEpoch = static_cast<long long>(rhs.toEpoch(rTicks));
+	return fixed_met<T>(lEpoch - rEpoch, lTicks - rTicks);
+}
+
+template <long long T> std::ostream& operator<<(std::ostream& os, const fixed_tm<T>& time) {
+	char text[FORMAT_BUFFER_SIZE];
+	return os.write(text, static_cast<std::streamsize>(time.format(text, sizeof(text))));
+}
+
+// Exact MET <-> UTC conversion, as TimeConverter but with fixed_tm
+// times and fixed_met METs throughout
+template <long long TicksPerSecond>
+class FixedTimeConverter {
+public:
+	// Every conversion uses the given context, held for the lifetime
+	// of the converter; by default, the default context at construction
+	FixedTimeConverter(const size_t sinceEpoch, const long long sinceEpochTicks, const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault())
+		: context(context), missionStart(static_cast<long long>(sinceEpoch), sinceEpochTicks) {}
+
+	FixedTimeConverter(const fixed_tm<TicksPerSecond>& missionStartTM, const std::shared_ptr<const TimeContext>& context = TimeContext::sharedDefault())
+		: context(context) {
+		long long startTicks;
+		const long long startEpoch = static_cast<long long>(missionStartTM.toEpoch(startTicks, *context));
+		missionStart = fixed_met<TicksPerSecond>(startEpoch, startTicks);
+	}
+
+	fixed_met<TicksPerSecond> toMET(const fixed_tm<TicksPerSecond>& time) const {
+		size_t leapHint = 0;
+		return toMET(time, leapHint);
+	}
+
+	fixed_tm<TicksPerSecond> toUTC(const fixed_met<TicksPerSecond>& MET) const {
+		size_t leapHint = 0;
+		return toUTC(MET, leapHint);
+	}
+
+	// Batch conversions of n values at a time, carrying the leap table
+	// position from each element to the next as TimeConverter's do
+	void toMET(const fixed_tm<TicksPerSecond>* times, const size_t n, fixed_met<TicksPerSecond>* METsOut) const {
+		size_t leapHint = 0;
+		for (size_t i = 0; i < n; ++i) METsOut[i] = toMET(times[i], leapHint);
+	}
+
+	void toUTC(const fixed_met<TicksPerSecond>* METs, const size_t n, fixed_tm<TicksPerSecond>* timesOut) const {
+		size_t leapHint = 0;
+		for (size_t i = 0; i < n; ++i) timesOut[i] = toUTC(METs[i], leapHint);
+	}
+
+private:
+	fixed_met<TicksPerSecond> toMET(const fixed_tm<TicksPerSecond>& time, size_t& leapHint) const {
+		long long ticks;
+		const long long sinceEpoch = static_cast<long long>(time.toEpoch(ticks, leapHint, *context));
+		return fixed_met<TicksPerSecond>(sinceEpoch, ticks) - missionStart;
+	}
+
+	fixed_tm<TicksPerSecond> toUTC(const fixed_met<TicksPerSecond>& MET, size_t& leapHint) const {
+		const fixed_met<TicksPerSecond> sinceEpoch = missionStart + MET;
+		return fixed_tm<TicksPerSecond>(static_cast<size_t>(sinceEpoch.sec), sinceEpoch.ticks, leapHint, *context);
+	}
+
+	std::shared_ptr<const TimeContext> context;
+
+	// mission start as seconds and ticks since epoch
+	fixed_met<TicksPerSecond> missionStart;
+};
+
+typedef fixed_tm<NANOS_PER_SECOND>		nano_tm;
+typedef fixed_tm<PICOS_PER_SECOND>		pico_tm;
+typedef fixed_met<NANOS_PER_SECOND>		nano_met;
+typedef fixed_met<PICOS_PER_SECOND>		pico_met;
+
+#endif
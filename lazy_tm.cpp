@@ -0,0 +1,35 @@
+/*******************************************************************
+*   lazy_tm.cpp
+*	Epoch-primary time with lazily computed calendar fields
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include "lazy_tm.h"
+
+lazy_tm::lazy_tm(const smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */)
+	: value(time, context), context(&context), fields(time), cached(true) {}
+
+lazy_tm lazy_tm::fromEpoch(const long long sinceEpoch, const double fracSec, const TimeContext& context /* =TimeContext::getDefault() */) {
+	return lazy_tm(smart_instant::fromEpoch(sinceEpoch, fracSec), context);
+}
+
+lazy_tm& lazy_tm::addSeconds(const double seconds) {
+	// fromEpoch() splits seconds into whole seconds (rounded down)
+	// and a fraction in [0, 1), as fixed point
+	const smart_instant delta = smart_instant::fromEpoch(0, seconds);
+	return add(delta.sinceEpoch, delta.frac);
+}
+
+void lazy_tm::materialize() const {
+	fields = value.toTM(*context);
+	cached = true;
+}
+
+std::ostream& operator<<(std::ostream& os, const lazy_tm& time) {
+	os << time.tm();
+	return os;
+}
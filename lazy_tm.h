@@ -0,0 +1,131 @@
+/*******************************************************************
+*   lazy_tm.h
+*	Epoch-primary time with lazily computed calendar fields
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// lazy_tm is for interval arithmetic over event lists, e.g. dead-time
+// and good-time-interval computations, where times are added to,
+// subtracted and compared millions of times but rarely printed.
+//
+// Its primary state is a smart_instant: the leap-aware seconds since
+// epoch and fixed-point fractional second. Adding seconds, subtracting
+// two times and comparing them are integer operations on that, with no
+// toEpoch() or adjust() calls. The calendar fields are only produced,
+// with smart_tm's constant-time epoch constructor, the first time one
+// is asked for after a change, and then cached until the next change.
+//
+// Each lazy_tm remembers the context it was created with, which must
+// outlive it; the default context always does. Times compared or
+// subtracted should share a context. A const lazy_tm fills its cache
+// on first access, so one shared between threads should have its
+// fields read once (or tm() called) before it is shared.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+
+lazy_tm start(smart_tm(2012, 6, 30, 23, 59, 59, 0.5));
+lazy_tm stop = start + 2;				// across the leap second
+std::cout << (stop - start) << std::endl;	// 2
+std::cout << stop << std::endl;			// 2012/07/01 00:00:00.5, computed only now
+
+*/
+
+#ifndef LAZY_TM_H
+#define LAZY_TM_H
+
+#include "smart_instant.h"
+#include "smart_tm.h"
+
+class lazy_tm {
+public:
+
+	// Create lazy_tm set to epoch of the given context
+	explicit lazy_tm(const TimeContext& context = TimeContext::getDefault())
+		: context(&context), fields(context), cached(true) {}
+
+	// Create lazy_tm from a (valid) smart_tm, whose fields become the cache
+	explicit lazy_tm(const smart_tm& time, const TimeContext& context = TimeContext::getDefault());
+
+	// Create lazy_tm at the same instant
+	lazy_tm(const smart_instant& instant, const TimeContext& context = TimeContext::getDefault())
+		: value(instant), context(&context), fields(context), cached(false) {}
+
+	// Create lazy_tm as seconds and fractional seconds since epoch.
+	// fracSec may be outside [0, 1); whole seconds are carried.
+	static lazy_tm fromEpoch(const long long sinceEpoch, const double fracSec, const TimeContext& context = TimeContext::getDefault());
+
+	const smart_instant& instant() const { return value; }
+	long long sinceEpoch() const { return value.sinceEpoch; }
+	double fracSec() const { return value.fracSec(); }
+	const TimeContext& timeContext() const { return *context; }
+
+	// The calendar fields, computed now if they have not been since the last change
+	const smart_tm& tm() const {
+		if (!cached) materialize();
+		return fields;
+	}
+
+	long long yr() const { return tm().yr; }
+	long long mon() const { return tm().mon; }
+	long long day() const { return tm().day; }
+	long long hr() const { return tm().hr; }
+	long long min() const { return tm().min; }
+	long long sec() const { return tm().sec; }
+
+	// Move by whole (leap-aware) seconds; only invalidates the cache
+	lazy_tm& operator+=(const long long seconds) {
+		value.sinceEpoch += seconds;
+		cached = false;
+		return *this;
+	}
+
+	lazy_tm& operator-=(const long long seconds) { return *this += -seconds; }
+
+	// Move by seconds plus a fixed-point fraction (units of 2^-64 seconds),
+	// carrying between them
+	lazy_tm& add(const long long seconds, const uint64_t frac) {
+		const uint64_t sum = value.frac + frac;
+		value.sinceEpoch += seconds + ((sum < frac) ? 1 : 0);
+		value.frac = sum;
+		cached = false;
+		return *this;
+	}
+
+	// Move by a fractional number of seconds, e.g. 0.25 or -1.5
+	lazy_tm& addSeconds(const double seconds);
+
+	std::string toString(const char dateSeparator='/') const { return tm().toString(dateSeparator); }
+
+private:
+	void materialize() const;
+
+	smart_instant value;
+	const TimeContext* context;
+
+	mutable smart_tm fields;
+	mutable bool cached;
+};
+
+inline bool operator==(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() == rhs.instant(); }
+inline bool operator!=(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() != rhs.instant(); }
+inline bool operator<(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() < rhs.instant(); }
+inline bool operator>(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() > rhs.instant(); }
+inline bool operator<=(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() <= rhs.instant(); }
+inline bool operator>=(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() >= rhs.instant(); }
+
+// Difference in seconds, as smart_tm's operator-, without toEpoch() calls
+inline double operator-(const lazy_tm& lhs, const lazy_tm& rhs) { return lhs.instant() - rhs.instant(); }
+
+inline lazy_tm operator+(lazy_tm time, const long long seconds) { return time += seconds; }
+inline lazy_tm operator-(lazy_tm time, const long long seconds) { return time -= seconds; }
+
+std::ostream& operator<<(std::ostream& os, const lazy_tm& time);
+
+#endif
@@ -0,0 +1,64 @@
+/*******************************************************************
+*   smart_clock.cpp
+*	std::chrono clock on the leap-aware smart_tm epoch count
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+#include "smart_clock.h"
+
+#define NANOS_PER_SECOND_DOUBLE		(1e9)
+
+// Unix seconds of the context's epoch, Jan 1 00:00:00 of its epoch year
+static long long unixSecondsOfEpoch(const TimeContext& context) {
+	return daysFromCivil(context.epochYear(), START_MON, START_DAY) * SECONDS_PER_DAY - NTP_TO_UNIX_SECONDS;
+}
+
+long long smart_clock::fromUnixSeconds(const long long unixSec, const TimeContext& context /* =TimeContext::getDefault() */) {
+	const long long nonleap = unixSec - unixSecondsOfEpoch(context);
+
+	// leap second i falls at epoch second deltas[i], right before the
+	// nonleap time deltas[i] - i, and every leap second whose following
+	// time is at or before nonleap has been walked through...
+	const std::vector<size_t>& deltas = context.leapSecondEpochs();
+	const long long n = static_cast<long long>(deltas.size());
+	const auto walkedThrough = [&](const long long i) { return static_cast<long long>(deltas[i]) - i <= nonleap; };
+
+	// ...which is all of them for any time after the last one
+	if (n == 0 || walkedThrough(n - 1)) return nonleap + n;
+
+	long long lo = 0, hi = n - 1;
+	while (lo < hi) {
+		const long long mid = lo + (hi - lo) / 2;
+		if (walkedThrough(mid)) lo = mid + 1;
+		else hi = mid;
+	}
+	return nonleap + lo;
+}
+
+long long smart_clock::toUnixSeconds(const long long sinceEpoch, const TimeContext& context /* =TimeContext::getDefault() */) {
+	// subtract the leap seconds strictly before this time; a leap second
+	// itself thus lands on the following nonleap second
+	const std::vector<size_t>& deltas = context.leapSecondEpochs();
+	long long before = static_cast<long long>(deltas.size());
+	if (before && static_cast<long long>(deltas.back()) >= sinceEpoch) {
+		before = std::lower_bound(deltas.begin(), deltas.end(), sinceEpoch,
+			[](const size_t leapSecond, const long long time) { return static_cast<long long>(leapSecond) < time; }) - deltas.begin();
+	}
+	return sinceEpoch - before + unixSecondsOfEpoch(context);
+}
+
+smart_clock::time_point smart_clock::fromTM(const smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */) {
+	double fracSec;
+	const long long wholeSec = static_cast<long long>(time.toEpoch(fracSec, context));
+	return time_point(std::chrono::seconds(wholeSec) + duration(llround(fracSec * NANOS_PER_SECOND_DOUBLE)));
+}
+
+smart_tm smart_clock::toTM(const time_point& time, const TimeContext& context /* =TimeContext::getDefault() */) {
+	const time_point wholeSec = std::chrono::floor<std::chrono::seconds>(time);
+	const double fracSec = static_cast<double>((time - wholeSec).count()) / NANOS_PER_SECOND_DOUBLE;
+	return smart_tm(static_cast<size_t>(std::chrono::duration_cast<std::chrono::seconds>(wholeSec.time_since_epoch()).count()), fracSec, context);
+}
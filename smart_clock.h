@@ -0,0 +1,84 @@
+/*******************************************************************
+*   smart_clock.h
+*	std::chrono clock on the leap-aware smart_tm epoch count
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// smart_clock is a std::chrono clock whose time_points count what
+// smart_tm's toEpoch() does: seconds since the context's epoch
+// INCLUDING leap seconds, here in nanoseconds. Differences of its
+// time_points are therefore true elapsed time, even across a leap
+// second, unlike system_clock's.
+//
+// now() and the system_clock conversions cost one leap table lookup,
+// which for times after the last leap second is a single comparison,
+// with no time_t, gmtime() or tm in between, so stamping every packet
+// in an acquisition loop stays cheap. smart_tm conversions go through
+// the constant-time epoch constructor and toEpoch().
+//
+// system_clock (Unix time) cannot represent a leap second itself:
+// to_sys() maps second '60' to the first second of the next minute,
+// as Unix time does, and from_sys() never produces one.
+//
+// With 64-bit nanoseconds, time_points reach about 292 years past epoch.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+
+const smart_clock::time_point stamp = smart_clock::now();
+...
+const smart_clock::duration elapsed = smart_clock::now() - stamp;
+std::cout << smart_clock::toTM(stamp) << std::endl;
+
+*/
+
+#ifndef SMART_CLOCK_H
+#define SMART_CLOCK_H
+
+#include <chrono>
+
+#include "smart_tm.h"
+
+struct smart_clock {
+	typedef std::chrono::nanoseconds				duration;
+	typedef duration::rep							rep;
+	typedef duration::period						period;
+	typedef std::chrono::time_point<smart_clock>	time_point;
+
+	static constexpr bool is_steady = false;
+
+	// The current time, from system_clock
+	static time_point now(const TimeContext& context = TimeContext::getDefault()) {
+		return from_sys(std::chrono::system_clock::now(), context);
+	}
+
+	// From and to system_clock time, as for C++20's clock_cast
+	template <typename Duration>
+	static time_point from_sys(const std::chrono::time_point<std::chrono::system_clock, Duration>& time, const TimeContext& context = TimeContext::getDefault()) {
+		const std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds> wholeSec = std::chrono::floor<std::chrono::seconds>(time);
+		return time_point(std::chrono::seconds(fromUnixSeconds(wholeSec.time_since_epoch().count(), context)) +
+			std::chrono::duration_cast<duration>(time - wholeSec));
+	}
+
+	static std::chrono::system_clock::time_point to_sys(const time_point& time, const TimeContext& context = TimeContext::getDefault()) {
+		const time_point wholeSec = std::chrono::floor<std::chrono::seconds>(time);
+		const std::chrono::seconds unixSec(toUnixSeconds(std::chrono::duration_cast<std::chrono::seconds>(wholeSec.time_since_epoch()).count(), context));
+		return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(unixSec + (time - wholeSec)));
+	}
+
+	// From and to smart_tm; fractional seconds are rounded to the nearest nanosecond
+	static time_point fromTM(const smart_tm& time, const TimeContext& context = TimeContext::getDefault());
+	static smart_tm toTM(const time_point& time, const TimeContext& context = TimeContext::getDefault());
+
+	// Leap-aware seconds since epoch of a Unix time, and the reverse
+	static long long fromUnixSeconds(const long long unixSec, const TimeContext& context = TimeContext::getDefault());
+	static long long toUnixSeconds(const long long sinceEpoch, const TimeContext& context = TimeContext::getDefault());
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*******************************************************************
+*   smart_instant.cpp
+*	Compact leap-aware instant
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// smart_instant is a packed, 16-byte alternative to smart_tm for
+// storing large numbers of times. It holds the same leap-aware
+// seconds since epoch that smart_tm's toEpoch() returns, as a signed
+// 64-bit count, plus the fractional second in fixed point
+// (units of 2^-64 seconds).
+
+#include "smart_instant.h"
+
+static_assert(sizeof(smart_instant) == 16, "smart_instant should pack into 16 bytes");
+
+// fracSec must be in [0, 1). Since the largest such double is 1 - 2^-53,
+// the product cannot reach 2^64.
+static inline uint64_t toFracUnits(const double fracSec) {
+	return static_cast<uint64_t>(fracSec * FRAC_UNITS_PER_SECOND);
+}
+
+smart_instant smart_instant::fromEpoch(const long long sinceEpoch, const double fracSec) {
+	const long long wholeSec = static_cast<long long>(floor(fracSec));
+	const double wrapped = fracSec - floor(fracSec);
+
+	// a tiny negative fracSec wraps to 1 - 2^-54 or so, which rounds to
+	// exactly 1.0: that is the start of the next second, not a fraction
+	if (wrapped >= 1.0) return smart_instant(sinceEpoch + wholeSec + 1, 0);
+	return smart_instant(sinceEpoch + wholeSec, toFracUnits(wrapped));
+}
+
+smart_instant::smart_instant(const smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */) {
+	double fracSec;
+	const long long wholeSec = static_cast<long long>(time.toEpoch(fracSec, context));
+	*this = fromEpoch(wholeSec, fracSec);
+}
+
+smart_instant::smart_instant(const smart_tm& time, size_t& leapHint, const TimeContext& context /* =TimeContext::getDefault() */) {
+	double fracSec;
+	const long long wholeSec = static_cast<long long>(time.toEpoch(fracSec, leapHint, context));
+	*this = fromEpoch(wholeSec, fracSec);
+}
+
+smart_tm smart_instant::toTM(const TimeContext& context /* =TimeContext::getDefault() */) const {
+	return smart_tm(static_cast<size_t>(sinceEpoch), fracSec(), context);
+}
+
+smart_tm smart_instant::toTM(size_t& leapHint, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	return smart_tm(static_cast<size_t>(sinceEpoch), fracSec(), leapHint, context);
+}
+
+std::ostream& operator<<(std::ostream& os, const smart_instant& instant) {
+	os << instant.toTM();
+	return os;
+}
+
+void toInstants(const smart_tm* times, const size_t n, smart_instant* instantsOut, const TimeContext& context /* =TimeContext::getDefault() */) {
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		instantsOut[i] = smart_instant(times[i], leapHint, context);
+	}
+}
+
+void toTMs(const smart_instant* instants, const size_t n, smart_tm* timesOut, const TimeContext& context /* =TimeContext::getDefault() */) {
+	size_t leapHint = 0;
+	for (size_t i = 0; i < n; ++i) {
+		timesOut[i] = instants[i].toTM(leapHint, context);
+	}
+}
@@ -0,0 +1,132 @@
+/*******************************************************************
+*   smart_instant.h
+*	Compact leap-aware instant
+*   Smart Time System
+*	Kareem Omar
+*	Student Researcher, CSPAR - UAH Class of 2017
+*
+*	10/14/2026
+*******************************************************************/
+
+// smart_instant is a packed, 16-byte alternative to smart_tm for
+// storing large numbers of times. It holds the same leap-aware
+// seconds since epoch that smart_tm's toEpoch() returns, as a signed
+// 64-bit count, plus the fractional second in fixed point
+// (units of 2^-64 seconds).
+//
+// Comparison, hashing and subtraction work directly on the packed
+// form and are plain integer operations, so arrays of instants sort
+// and search far faster than arrays of smart_tm. Calendar fields
+// are produced on demand via toTM(), which uses smart_tm's
+// constant-time epoch constructor and thus its leap table.
+//
+// Conversion from smart_tm is exact for fractional seconds of
+// 2^-11 seconds or more, and within 2^-64 seconds otherwise.
+//
+// Example:
+/*
+
+smart_tm::init(1990, "leap-seconds.list");
+
+std::vector<smart_instant> events;
+events.push_back(smart_instant(smart_tm(2012, 6, 30, 23, 59, 60, 0.25)));
+...
+std::sort(events.begin(), events.end());
+std::cout << events.front().toTM() << std::endl;
+
+*/
+
+#ifndef SMART_INSTANT_H
+#define SMART_INSTANT_H
+
+#include <cstdint>
+#include <functional>
+
+#include "smart_tm.h"
+
+// 2^64 and 2^-64, for fixed-point fractional seconds
+#define FRAC_UNITS_PER_SECOND		(18446744073709551616.0)
+#define SECONDS_PER_FRAC_UNIT		(5.42101086242752217e-20)
+
+class smart_instant {
+
+// Variables:
+
+public:
+	// leap-aware seconds since epoch
+	long long	sinceEpoch;
+
+	// fractional second, in units of 2^-64 seconds
+	uint64_t	frac;
+
+// Methods:
+
+public:
+
+	// Create smart_instant set to epoch
+	smart_instant() : sinceEpoch(0), frac(0) {}
+
+	// Create smart_instant from raw seconds since epoch and fixed-point fraction
+	smart_instant(const long long sinceEpoch, const uint64_t frac) : sinceEpoch(sinceEpoch), frac(frac) {}
+
+	// Create smart_instant from a smart_tm, valid in the given context
+	explicit smart_instant(const smart_tm& time, const TimeContext& context = TimeContext::getDefault());
+
+	// Create smart_instant from a smart_tm, reusing and updating
+	// leapHint as in smart_tm's leapHint constructor
+	smart_instant(const smart_tm& time, size_t& leapHint, const TimeContext& context = TimeContext::getDefault());
+
+	// Create smart_instant as seconds and fractional seconds since epoch.
+	// fracSec may be outside [0, 1); whole seconds are carried.
+	static smart_instant fromEpoch(const long long sinceEpoch, const double fracSec);
+
+	// Fractional second as a double in [0, 1]
+	inline double fracSec() const { return static_cast<double>(frac) * SECONDS_PER_FRAC_UNIT; }
+
+	// Return seconds since epoch, including fractional seconds
+	inline size_t toEpoch(double& fracSec) const { fracSec = this->fracSec(); return static_cast<size_t>(sinceEpoch); }
+
+	// Create the equivalent smart_tm in the given context
+	smart_tm toTM(const TimeContext& context = TimeContext::getDefault()) const;
+
+	// Create the equivalent smart_tm, reusing and updating
+	// leapHint as in smart_tm's leapHint constructor
+	smart_tm toTM(size_t& leapHint, const TimeContext& context = TimeContext::getDefault()) const;
+};
+
+inline bool operator==(const smart_instant& lhs, const smart_instant& rhs) { return lhs.sinceEpoch == rhs.sinceEpoch && lhs.frac == rhs.frac; }
+inline bool operator!=(const smart_instant& lhs, const smart_instant& rhs) { return !(lhs == rhs); }
+
+inline bool operator<(const smart_instant& lhs, const smart_instant& rhs) {
+	return (lhs.sinceEpoch == rhs.sinceEpoch) ? (lhs.frac < rhs.frac) : (lhs.sinceEpoch < rhs.sinceEpoch);
+}
+
+inline bool operator>(const smart_instant& lhs, const smart_instant& rhs) { return rhs < lhs; }
+inline bool operator<=(const smart_instant& lhs, const smart_instant& rhs) { return !(lhs > rhs); }
+inline bool operator>=(const smart_instant& lhs, const smart_instant& rhs) { return !(lhs < rhs); }
+
+// Difference in seconds, as smart_tm's operator-
+inline double operator-(const smart_instant& lhs, const smart_instant& rhs) {
+	const double fracDiff = (lhs.frac >= rhs.frac) ?
+		static_cast<double>(lhs.frac - rhs.frac) * SECONDS_PER_FRAC_UNIT :
+		-static_cast<double>(rhs.frac - lhs.frac) * SECONDS_PER_FRAC_UNIT;
+	return static_cast<double>(lhs.sinceEpoch - rhs.sinceEpoch) + fracDiff;
+}
+
+std::ostream& operator<<(std::ostream& os, const smart_instant& instant);
+
+// Array conversions, carrying the leap table position from each element to the next
+void toInstants(const smart_tm* times, const size_t n, smart_instant* instantsOut, const TimeContext& context = TimeContext::getDefault());
+void toTMs(const smart_instant* instants, const size_t n, smart_tm* timesOut, const TimeContext& context = TimeContext::getDefault());
+
+namespace std {
+	template <>
+	struct hash<smart_instant> {
+		size_t operator()(const smart_instant& instant) const {
+			const size_t h = hash<long long>()(instant.sinceEpoch);
+			return h ^ (hash<uint64_t>()(instant.frac) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+		}
+	};
+}
+
+#endif
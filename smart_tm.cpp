@@ -64,70 +64,23 @@ std::cout << myTime << std::endl;
 */
 
 #include "smart_tm.h"
+#include "CivilSIMD.h"
+#include "TimeStats.h"
 
-std::vector<smart_tm> smart_tm::leapSecondTMs;
-std::vector<size_t> smart_tm::leapSecondDeltas;
-smart_tm smart_tm::epoch(DEFAULT_EPOCH_YEAR, START_MON, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC);
-bool smart_tm::initialized = false;
-
-const short smart_tm::days[MONTHS_PER_YEAR] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+constexpr short smart_tm::days[MONTHS_PER_YEAR];
+constexpr short smart_tm::daysBeforeMon[MONTHS_PER_YEAR];
 
 void smart_tm::init(const long long epochYr, const std::string& leapFile) {
+	// on failure to open the file, the current default stays in place
+	TimeContext::setDefault(TimeContext::create(epochYr, leapFile));
+}
 
-	std::ifstream fLeap(leapFile);
-
-	if (!fLeap) {
-		std::cerr << "ERROR: Failed to open " << leapFile << '.' << std::endl;
-		return;
-	}
-
-	leapSecondTMs.clear();
-	leapSecondDeltas.clear();
-	
-	// leap file gives leap second times as seconds since epoch with year 1900,
-	// but smart_tm allows users to specify an epoch, so we must get the number
-	// of seconds in between and subtract that from each leap second
-	const size_t defaultEpochToNewEpoch = numSecondsBetweenEpochs(DEFAULT_EPOCH_YEAR, epochYr);
-	
-	size_t defaultEpochToLeapSecond;
-	size_t leapSecondsSoFar = 0;
-
-	std::string strLine;
-	initialized = true;
-	while (getNextLine(fLeap, strLine)) {
-
-		defaultEpochToLeapSecond = static_cast<size_t>(strtoull(strLine.substr(0, strLine.find_first_not_of("0123456789")).c_str(), nullptr, BASE_10_PLEASE));
-
-		// the leap file gives time since 1900
-		// Unix-style, i.e. ignoring leap seconds. 
-		// smart_tm does not conform to this behavior, instead considering
-		// epoch a monotonic counter INCLUDING leap seconds.
-		// Therefore we must manually add 1 second to the leap file time
-		// for each leap second we've already passed.
-		if (defaultEpochToLeapSecond > defaultEpochToNewEpoch) {
-			leapSecondDeltas.push_back(defaultEpochToLeapSecond - defaultEpochToNewEpoch + leapSecondsSoFar);
-			leapSecondTMs.push_back(smart_tm(defaultEpochToLeapSecond + leapSecondsSoFar++));
-
-			// this puts us at second '59' since the Unix/nonleap
-			// counters repeat the '59' time during the leap second
-			// (at '60') so we manually add 1 to put the second value at 60
-
-			++leapSecondTMs.back().sec;
-		}
-	}
-
-	fLeap.close();
-
-	// now that all (valid) leap seconds have been added,
-	// we can update the epoch according to the user's request
-	epoch.yr = epochYr;
+void smart_tm::init(const long long epochYr) {
+	TimeContext::setDefault(TimeContext::create(epochYr));
 }
 
 void smart_tm::checkInit() {
-	if (!initialized) {
-		std::cerr << "WARN: smart_tm not initialized! This means no leap second handling" << std::endl
-			<< "and default epoch of " << DEFAULT_EPOCH_YEAR << '.' << std::endl;
-	}
+	TimeContext::getDefault().checkInit();
 }
 
 smart_tm::smart_tm(const tm& c_tm) {
@@ -152,19 +105,81 @@ smart_tm::smart_tm(const tm& c_tm, const double fracSec) {
 	this->fracSec = fracSec;
 }
 
-smart_tm::smart_tm(const size_t sinceEpoch) {
-	checkInit();
-	*this = epoch;
-	sec += sinceEpoch;
-	adjust();
+smart_tm::smart_tm(const size_t sinceEpoch, const TimeContext& context /* =TimeContext::getDefault() */) : smart_tm(context) {
+	context.checkInit();
+	size_t leapHint = 0;
+	setFromEpoch(static_cast<long long>(sinceEpoch), leapHint, context);
 }
 
-smart_tm::smart_tm(const size_t sinceEpoch, const double fracSec) {
-	checkInit();
-	*this = epoch;
-	sec += sinceEpoch;
+smart_tm::smart_tm(const size_t sinceEpoch, const double fracSec, const TimeContext& context /* =TimeContext::getDefault() */) : smart_tm(context) {
+	context.checkInit();
+	this->fracSec += fracSec;
+	size_t leapHint = 0;
+	setFromEpoch(static_cast<long long>(sinceEpoch) + carryFracSec(), leapHint, context);
+}
+
+smart_tm::smart_tm(const size_t sinceEpoch, const double fracSec, size_t& leapHint, const TimeContext& context /* =TimeContext::getDefault() */) : smart_tm(context) {
+	context.checkInit();
 	this->fracSec += fracSec;
-	adjust();
+	setFromEpoch(static_cast<long long>(sinceEpoch) + carryFracSec(), leapHint, context);
+}
+
+long long smart_tm::carryFracSec() {
+	if (fracSecInLimits()) return 0;
+
+	const long long count = static_cast<long long>(floor(fracSec - START_FRAC_SEC));
+	fracSec -= static_cast<double>(count);
+	return count;
+}
+
+// Number of leading elements of sorted 'v' for which below(element) holds.
+// Checks whether 'hint' (or the position just after it, for increasing
+// input crossing one boundary) is already the answer before binary searching,
+// and stores the answer back into 'hint'.
+template <typename T, typename Below>
+static size_t hintedPartitionPoint(const std::vector<T>& v, size_t& hint, const Below below) {
+	TIME_STATS_COUNT(LeapLookups);
+	const size_t n = v.size();
+	if (hint <= n && (hint == 0 || below(v[hint - 1]))) {
+		if (hint == n || !below(v[hint])) {
+			TIME_STATS_COUNT(LeapHintHits);
+			return hint;
+		}
+		if (hint + 1 == n || !below(v[hint + 1])) {
+			TIME_STATS_COUNT(LeapHintHits);
+			return ++hint;
+		}
+	}
+
+	hint = std::partition_point(v.begin(), v.end(), below) - v.begin();
+	return hint;
+}
+
+void smart_tm::setFromEpoch(const long long sinceEpoch, size_t& leapHint, const TimeContext& context) {
+	const std::vector<size_t>& leapSecondDeltas = context.leapSecondDeltas;
+
+	// count the leap seconds strictly before this time. leapSecondDeltas
+	// holds the epoch time of each leap second itself, sorted ascending.
+	const long long leapSecondsBefore = static_cast<long long>(hintedPartitionPoint(leapSecondDeltas, leapHint,
+		[sinceEpoch](const size_t leapSecond) { return static_cast<long long>(leapSecond) < sinceEpoch; }));
+
+	const bool onLeapSecond = leapSecondsBefore < static_cast<long long>(leapSecondDeltas.size()) && static_cast<long long>(leapSecondDeltas[leapSecondsBefore]) == sinceEpoch;
+
+	// from here the seconds count is nonleap, i.e. every day has exactly SECONDS_PER_DAY
+	const long long nonleap = sinceEpoch - leapSecondsBefore - (onLeapSecond ? 1 : 0);
+
+	// floor division, so times before epoch land on the correct day
+	long long dayCount = nonleap / SECONDS_PER_DAY;
+	long long secOfDay = nonleap % SECONDS_PER_DAY;
+	if (secOfDay < 0) {
+		secOfDay += SECONDS_PER_DAY;
+		--dayCount;
+	}
+
+	civilFromDays(daysFromCivil(context.epochYr, START_MON, START_DAY) + dayCount, yr, mon, day);
+	hr = secOfDay / SECONDS_PER_HOUR + START_HR;
+	min = (secOfDay % SECONDS_PER_HOUR) / TYPICAL_SECONDS_PER_MINUTE + START_MIN;
+	sec = secOfDay % TYPICAL_SECONDS_PER_MINUTE + START_SEC + (onLeapSecond ? 1 : 0);
 }
 
 bool smart_tm::equalsWithFrac(const smart_tm& other) const {
@@ -175,73 +190,253 @@ bool smart_tm::equalsNoFrac(const smart_tm& other) const {
 	return yr == other.yr && mon == other.mon && day == other.day && hr == other.hr && min == other.min && sec == other.sec;
 }
 
-std::string smart_tm::dateToString(const char dateSeparator /* ='/' */) const {
-	std::stringstream ss;
-	ss << std::setfill('0') << std::setw(4) << yr << dateSeparator
-		<< std::setw(2) << mon << dateSeparator
-		<< std::setw(2) << day;
-	return ss.str();
+char* writePadded(char* out, const long long value, const int width) {
+	// digits, in reverse, of the magnitude...
+	char digitsReversed[FORMAT_BUFFER_SIZE];
+	int len = 0;
+	unsigned long long magnitude = (value < 0) ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+	do {
+		digitsReversed[len++] = static_cast<char>('0' + magnitude % BASE_10_PLEASE);
+		magnitude /= BASE_10_PLEASE;
+	} while (magnitude);
+	if (value < 0) digitsReversed[len++] = '-';
 
+	// ...right-aligned in width, as with the default iostream adjustfield
+	for (int i = len; i < width; ++i) *out++ = '0';
+	while (len) *out++ = digitsReversed[--len];
+	return out;
 }
 
-std::string smart_tm::timeToString() const {
-	std::stringstream ss;
+char* smart_tm::formatDate(char* out, const char dateSeparator) const {
+	out = writePadded(out, yr, 4);
+	*out++ = dateSeparator;
+	out = writePadded(out, mon, 2);
+	*out++ = dateSeparator;
+	return writePadded(out, day, 2);
+}
+
+char* smart_tm::formatTime(char* out) const {
 	double combinedSec = static_cast<double>(sec) + fracSec;
-	ss << std::setfill('0') << std::setw(2) << hr << ':'
-                << std::setw(2) << min << ':'
-                << ((combinedSec >= 0.0 && combinedSec < 10.0) ? "0" : "") << std::setw(0) << std::setprecision(digits) << combinedSec;
-        return ss.str();
+	out = writePadded(out, hr, 2);
+	*out++ = ':';
+	out = writePadded(out, min, 2);
+	*out++ = ':';
+	if (combinedSec >= 0.0 && combinedSec < 10.0) *out++ = '0';
+
+	// same as an iostream with setprecision(digits), without the stream.
+	// Worst case is sign, digits, point and a 5-character exponent.
+	return out + snprintf(out, digits + 8, "%.*g", static_cast<int>(digits), combinedSec);
+}
+
+size_t smart_tm::format(char* buf, const size_t cap, const char dateSeparator /* ='/' */) const {
+	char text[FORMAT_BUFFER_SIZE];
+	char* end = formatDate(text, dateSeparator);
+	*end++ = ' ';
+	end = formatTime(end);
+
+	const size_t len = end - text;
+	if (len > cap) return 0;
+
+	memcpy(buf, text, len);
+	if (len < cap) buf[len] = '\0';
+	return len;
+}
+
+std::string smart_tm::dateToString(const char dateSeparator /* ='/' */) const {
+	char text[FORMAT_BUFFER_SIZE];
+	return std::string(text, formatDate(text, dateSeparator));
+}
+
+std::string smart_tm::timeToString() const {
+	char text[FORMAT_BUFFER_SIZE];
+	return std::string(text, formatTime(text));
 }
 
 std::string smart_tm::toString(const char dateSeparator /* ='/' */) const {
-	return dateToString(dateSeparator) + ' ' + timeToString();
+	char text[FORMAT_BUFFER_SIZE];
+	return std::string(text, format(text, FORMAT_BUFFER_SIZE, dateSeparator));
 }
 
 std::ostream& operator<<(std::ostream& os, const smart_tm& time) {
-	os << time.toString();
+	char text[FORMAT_BUFFER_SIZE];
+	time.format(text, FORMAT_BUFFER_SIZE);
+	os << text;
 	return os;
 }
 
-bool isLeapYear(size_t yr) {
-	// Leap years occur on years evenly divisible by 4, except on
-	// years divisible by 100 but not by 400.
-	return (yr % 4 == 0) && ((yr % 400 == 0) || (yr % 100 != 0));
+long long smart_tm::dayOfYear() const {
+	return daysBeforeMon[mon - 1] + day + ((mon - 1 > Month::Feb && isLeapYear()) ? 1 : 0);
+}
+
+static inline bool isDigit(const char c) {
+	return c >= '0' && c <= '9';
+}
+
+// Read exactly 'count' digits at p, advancing p past them
+static inline bool readDigits(const char*& p, const char* last, const int count, long long& value) {
+	if (last - p < count) return false;
+
+	value = 0;
+	for (int i = 0; i < count; ++i) {
+		if (!isDigit(p[i])) return false;
+		value = value * BASE_10_PLEASE + (p[i] - '0');
+	}
+	p += count;
+	return true;
+}
+
+static inline bool readChar(const char*& p, const char* last, const char c) {
+	if (p == last || *p != c) return false;
+	++p;
+	return true;
+}
+
+// Read the fractional part after a decimal point at p, advancing p past it
+static inline double readFracSec(const char*& p, const char* last) {
+	const char* start = p;
+	unsigned long long digits = 0;
+	while (p < last && isDigit(*p)) {
+		if (p - start < 15) digits = digits * BASE_10_PLEASE + (*p - '0');
+		++p;
+	}
+
+	// up to 15 digits and their power of 10 are both exact doubles,
+	// so one division gives the correctly rounded value...
+	static const double powersOf10[16] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+	if (p - start <= 15) return static_cast<double>(digits) / powersOf10[p - start];
+
+	// ...but beyond that, leave the rounding to strtod()
+	char text[FORMAT_BUFFER_SIZE] = "0.";
+	const size_t len = std::min(static_cast<size_t>(p - start), static_cast<size_t>(FORMAT_BUFFER_SIZE - 3));
+	memcpy(text + 2, start, len);
+	text[len + 2] = '\0';
+	return strtod(text, nullptr);
+}
+
+// Everything after the minute: ':ss', optional fraction, optional 'Z'
+static inline const char* parseSeconds(const char* p, const char* last, long long& sec, double& fracSec) {
+	if (!readChar(p, last, ':') || !readDigits(p, last, 2, sec)) return nullptr;
+
+	fracSec = START_FRAC_SEC;
+	if (p < last && (*p == '.' || *p == ',') && p + 1 < last && isDigit(p[1])) {
+		++p;
+		fracSec = readFracSec(p, last);
+	}
+
+	readChar(p, last, 'Z');
+	return p;
+}
+
+const char* smart_tm::parse(const char* first, const char* last, smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */) {
+	const char* p = first;
+	smart_tm ret(context);
+
+	if (!readDigits(p, last, 4, ret.yr)) return nullptr;
+
+	if (p == last || (*p != '/' && *p != '-' && *p != ':')) return nullptr;
+	const char dateSeparator = *p++;
+
+	// two digits is a month, three a day of year
+	long long dayOfYr = 0;
+	if (last - p >= 3 && isDigit(p[0]) && isDigit(p[1]) && isDigit(p[2])) {
+		readDigits(p, last, 3, dayOfYr);
+		if (dayOfYr < START_DAY || dayOfYr > TYPICAL_DAYS_PER_YEAR + (ret.isLeapYear() ? 1 : 0)) return nullptr;
+		civilFromDays(daysFromCivil(ret.yr, START_MON, START_DAY) + dayOfYr - START_DAY, ret.yr, ret.mon, ret.day);
+	}
+	else if (!readDigits(p, last, 2, ret.mon) || !readChar(p, last, dateSeparator) || !readDigits(p, last, 2, ret.day)) {
+		return nullptr;
+	}
+
+	if (p == last || (*p != 'T' && *p != ' ' && *p != dateSeparator)) return nullptr;
+	++p;
+
+	if (!readDigits(p, last, 2, ret.hr) || !readChar(p, last, ':') || !readDigits(p, last, 2, ret.min)) return nullptr;
+
+	p = parseSeconds(p, last, ret.sec, ret.fracSec);
+	if (!p || !ret.isValid(context)) return nullptr;
+
+	time = ret;
+	return p;
+}
+
+bool smart_tm::parse(const std::string& text, smart_tm& time, const TimeContext& context /* =TimeContext::getDefault() */) {
+	const char* last = text.data() + text.size();
+	smart_tm ret(context);
+	if (parse(text.data(), last, ret, context) != last) return false;
+
+	time = ret;
+	return true;
 }
 
-bool smart_tm::isLeapYear() const {
+size_t smart_tm::parseFixedWidth(const char* text, const size_t stride, const size_t n, smart_tm* timesOut, const TimeContext& context /* =TimeContext::getDefault() */) {
+	for (size_t i = 0; i < n; ++i) {
+		const char* record = text + i * stride;
+		const char* last = record + stride;
+		smart_tm& time = timesOut[i];
+
+		// the fixed-width prefix in one go if possible...
+		long long fields[5];
+		const char* p = (stride >= SIMD_DATE_PREFIX_LENGTH) ? parseDatePrefixSIMD(record, fields) : nullptr;
+		if (p) {
+			smart_tm ret(fields[0], fields[1], fields[2], fields[3], fields[4], START_SEC, START_FRAC_SEC);
+			p = parseSeconds(p, last, ret.sec, ret.fracSec);
+			if (!p || !ret.isValid(context)) return i;
+			time = ret;
+		}
+		// ...otherwise the general parse
+		else if (!parse(record, last, time, context)) {
+			return i;
+		}
+	}
+	return n;
+}
+
+bool isLeapYear(size_t yr) {
 	// Leap years occur on years evenly divisible by 4, except on
 	// years divisible by 100 but not by 400.
 	return (yr % 4 == 0) && ((yr % 400 == 0) || (yr % 100 != 0));
 }
 
-bool smart_tm::isLeapMinute() const {
-	for (auto&& leapSecond : leapSecondTMs) {
-		if (yr == leapSecond.yr && mon == leapSecond.mon && day == leapSecond.day && hr == leapSecond.hr && min == leapSecond.min)
-			return true;
-	}
-	return false;
-}
+bool smart_tm::isLeapMinute(const TimeContext& context /* =TimeContext::getDefault() */) const {
+	const std::vector<long long>& leapMinuteOrdinals = context.leapMinuteOrdinals;
+	if (leapMinuteOrdinals.empty()) return false;
+
+	// most times in use fall after the last (or before the first)
+	// leap second, so reject those with a single range check...
+	const long long ordinal = minuteOrdinal();
+	if (ordinal > leapMinuteOrdinals.back() || ordinal < leapMinuteOrdinals.front()) return false;
 
-short smart_tm::numDaysOfMonth() const {
-	// constant and dependent only on month...
-	// ...except leap years, where Feb has 29 instead of 28 days.
-	return ((mon - 1 == Month::Feb) && isLeapYear()) ? days[Month::Feb] + 1 : days[mon - 1];
+	// ...and otherwise search the sorted ordinals
+	TIME_STATS_COUNT(LeapMinuteSearches);
+	return std::binary_search(leapMinuteOrdinals.begin(), leapMinuteOrdinals.end(), ordinal);
 }
 
-short smart_tm::numSecondsOfMinute() const {
+short smart_tm::numSecondsOfMinute(const TimeContext& context) const {
 	// constant (60)...
 	// ...except leap minutes, where the minute has 60 seconds instead.
-	return isLeapMinute() ? 61 : 60;
+	return isLeapMinute(context) ? 61 : 60;
+}
+
+void civilFromDays(const long long days, long long& yr, long long& mon, long long& day) {
+	// inverse of daysFromCivil(), again counting from 1 March
+	const long long z = days + ERA_START_TO_DEFAULT_EPOCH;
+	const long long era = (z >= 0 ? z : z - (DAYS_PER_400_YEARS - 1)) / DAYS_PER_400_YEARS;
+	const long long dayOfEra = z - era * DAYS_PER_400_YEARS;
+	const long long yrOfEra = (dayOfEra - dayOfEra / DAYS_PER_4_YEARS + dayOfEra / DAYS_PER_100_YEARS - dayOfEra / (DAYS_PER_400_YEARS - 1)) / TYPICAL_DAYS_PER_YEAR;
+	const long long dayOfYr = dayOfEra - (TYPICAL_DAYS_PER_YEAR * yrOfEra + yrOfEra / 4 - yrOfEra / 100);
+	const long long shiftedMon = (5 * dayOfYr + 2) / 153;
+	day = dayOfYr - (153 * shiftedMon + 2) / 5 + START_DAY;
+	mon = shiftedMon < 10 ? shiftedMon + 3 : shiftedMon - 9;
+	yr = yrOfEra + era * 400 + (mon <= 2 ? 1 : 0);
 }
 
 size_t numSecondsBetweenEpochs(const size_t startYr, const size_t endYr) {
 	return (endYr - startYr)*SECONDS_PER_YEAR + leapDaysWalkedThroughFrom(startYr, endYr)*SECONDS_PER_DAY;
 }
 
-size_t smart_tm::toEpoch() const {
-	size_t sum = 0;
-	// step through the months since they vary in number of days
-	// does not correct for leap days since that would only account
+size_t smart_tm::nonleapSinceEpoch(const TimeContext& context) const {
+	// whole months come from the cumulative days table,
+	// which does not correct for leap days since that would only account
 	// for the months of the same year
 	// and not for all the whole years stepped through on the 
 	// way from epoch to current time.
@@ -250,33 +445,48 @@ size_t smart_tm::toEpoch() const {
 	// this step would only count the 1 leap year in Feb 2012.
 	//
 	// Instead, no correction is applied here, and the full correction
-	// occurs below via leapDaysWalkedThroughSinceEpoch().
-	for (long long i = 0; i < mon - 1; ++i) {
-		sum += days[i] * SECONDS_PER_DAY;
-	}
-
-	// the remainder of terms can be added directly
-	// with correction applied for leap days and seconds
-	sum += (yr - epoch.yr)*SECONDS_PER_YEAR + (day - START_DAY)*SECONDS_PER_DAY + (hr - START_HR)*SECONDS_PER_HOUR + (min - START_MIN)*TYPICAL_SECONDS_PER_MINUTE + leapDaysWalkedThroughSinceEpoch()*SECONDS_PER_DAY + leapSecondsWalkedThroughSinceEpoch();
+	// comes from the leap days before this date less those before
+	// epoch, which the context has already cached.
+	//
+	// No loops, so this is straight-line integer arithmetic.
+	size_t sum = (yr - context.epochYr)*SECONDS_PER_YEAR + (daysBeforeMon[mon - 1] + day - START_DAY)*SECONDS_PER_DAY + (hr - START_HR)*SECONDS_PER_HOUR + (min - START_MIN)*TYPICAL_SECONDS_PER_MINUTE;
+	sum += (leapDaysBefore(yr, mon, day) - context.epochLeapDays)*SECONDS_PER_DAY;
 	return sum + sec - START_SEC;
 }
 
-size_t smart_tm::toEpoch(double& fracSec) const {
+size_t smart_tm::toEpoch(const TimeContext& context /* =TimeContext::getDefault() */) const {
+	// correct the nonleap count for leap seconds,
+	// looked up by that same nonleap count
+	const size_t nonleap = nonleapSinceEpoch(context);
+	size_t leapHint = 0;
+	return nonleap + leapSecondsWalkedThroughSinceEpoch(static_cast<long long>(nonleap), leapHint, context);
+}
+
+size_t smart_tm::toEpoch(double& fracSec, const TimeContext& context /* =TimeContext::getDefault() */) const {
 	fracSec = this->fracSec;
-	return toEpoch();
+	return toEpoch(context);
 }
 
-size_t smart_tm::leapSecondsWalkedThroughSinceEpoch() const {
-	size_t ret = 0;
-	for (auto&& leapSecond : leapSecondTMs) {
-		if (*this > leapSecond && !equalsNoFrac(leapSecond)) ++ret;
-	}
+size_t smart_tm::toEpoch(double& fracSec, size_t& leapHint, const TimeContext& context /* =TimeContext::getDefault() */) const {
+	fracSec = this->fracSec;
+	const size_t nonleap = nonleapSinceEpoch(context);
+	return nonleap + leapSecondsWalkedThroughSinceEpoch(static_cast<long long>(nonleap), leapHint, context);
+}
+
+size_t smart_tm::leapSecondsWalkedThroughSinceEpoch(const long long nonleapSinceEpoch, size_t& leapHint, const TimeContext& context) const {
+	const std::vector<long long>& leapSecondNonleapEpochs = context.leapSecondNonleapEpochs;
+	size_t ret = hintedPartitionPoint(leapSecondNonleapEpochs, leapHint,
+		[nonleapSinceEpoch](const long long leapSecond) { return leapSecond <= nonleapSinceEpoch; });
+
+	// a leap second ('60') has the same nonleap count as the first
+	// second of the following minute, but has not yet walked through itself
+	if (ret && leapSecondNonleapEpochs[ret - 1] == nonleapSinceEpoch && sec - START_SEC >= TYPICAL_SECONDS_PER_MINUTE) --ret;
 
 	return ret;
 }
 
-size_t smart_tm::leapDaysWalkedThroughSinceEpoch() const {
-	return static_cast<size_t>(leapDaysWalkedThroughFrom(epoch, *this));
+size_t smart_tm::leapDaysWalkedThroughSinceEpoch(const TimeContext& context) const {
+	return static_cast<size_t>(leapDaysBefore(yr, mon, day) - context.epochLeapDays);
 }
 
 long long leapDaysWalkedThroughFrom(const size_t startYr, const size_t endYr) {
@@ -309,170 +519,56 @@ long long leapDaysWalkedThroughFrom(const smart_tm& start, const smart_tm& end)
 	return (calcYr / 4 + calcYr / 400 - calcYr / 100) - startCount;
 }
 
-void smart_tm::fixMon() {
-	if (monInLimits()) return;
+void smart_tm::adjust(const TimeContext& context /* =TimeContext::getDefault() */) {
+	TIME_STATS_COUNT(AdjustCalls);
+	if (isValid(context)) return;
 
-	long long count;
+	TIME_STATS_COUNT(AdjustSlowPaths);
+	TIME_STATS_TIME_ADJUST();
 
-	count = static_cast<long long>(floor(static_cast<double>(mon - START_MON) / static_cast<double>(MONTHS_PER_YEAR)));
-	yr += count;
-	mon -= count * MONTHS_PER_YEAR;
-}
+	// each field carries into the next larger one in a single floor
+	// division, so no value of any field costs more than another:
+	// months into years...
+	long long carry = floorDiv(mon - START_MON, MONTHS_PER_YEAR);
+	yr += carry;
+	mon -= carry * MONTHS_PER_YEAR;
 
-void smart_tm::stepMonNoLeapCorrection() {
-	while (day > START_DAY + days[mon - 1] - 1) {
-		day -= days[mon - 1];
-		++mon;
-		fixMon();
-	}
+	// ...minutes into hours and hours into days...
+	carry = floorDiv(min - START_MIN, MINUTES_PER_HOUR);
+	hr += carry;
+	min -= carry * MINUTES_PER_HOUR;
 
-	while (day < START_DAY) {
-		--mon;
-		fixMon();
-		day += days[mon - 1];
-	}
-}
+	carry = floorDiv(hr - START_HR, HOURS_PER_DAY);
+	day += carry;
+	hr -= carry * HOURS_PER_DAY;
 
-void smart_tm::stepMon() {
-	while (day > START_DAY + numDaysOfMonth() - 1) {
-		day -= numDaysOfMonth();
-		++mon;
-		fixMon();
-	}
+	// ...and days, however many, into a calendar date
+	civilFromDays(daysFromCivil(yr, mon, START_DAY) + (day - START_DAY), yr, mon, day);
 
-	while (day < START_DAY) {
-		--mon;
-		fixMon();
-		day += numDaysOfMonth();
-	}
+	// seconds, including any carried out of fracSec, then count elapsed
+	// (leap-aware) seconds from the start of the resulting minute
+	const long long elapsed = sec - START_SEC + carryFracSec();
+	const long long nonleap = (daysFromCivil(yr, mon, day) - daysFromCivil(context.epochYr, START_MON, START_DAY)) * SECONDS_PER_DAY +
+		(hr - START_HR) * SECONDS_PER_HOUR + (min - START_MIN) * TYPICAL_SECONDS_PER_MINUTE;
+	size_t leapHint = 0;
+	const long long leapSecondsBefore = static_cast<long long>(hintedPartitionPoint(context.leapSecondNonleapEpochs, leapHint,
+		[nonleap](const long long leapSecond) { return leapSecond <= nonleap; }));
+	setFromEpoch(nonleap + leapSecondsBefore + elapsed, leapHint, context);
 }
 
-void smart_tm::fixDay() {
-	if (dayInLimits()) return;
-
-	long long count;
-
-	// compute by marching forward from *first* day of month...
-	smart_tm old(yr, mon, START_DAY, START_HR, START_MIN, START_SEC, START_FRAC_SEC);
-
-	// ...first moving whole years since they do not vary like months
-	// thus improving compute speed versus stepping 1 month at a time all the way
-	// (although this does introduce leap day error, corrected below)
-	count = static_cast<long long>(static_cast<double>(day - START_DAY) / static_cast<double>(TYPICAL_DAYS_PER_YEAR));
-	yr += count;
-	day -= count * TYPICAL_DAYS_PER_YEAR;
-	stepMonNoLeapCorrection();
-
-	// ...now correct leap day error...
-	day -= leapDaysWalkedThroughFrom(old, *this);
-	// ...and bring the days and months in range.
-	stepMon();
-}
-
-void smart_tm::fixHr() {
-	if (hrInLimits()) return;
-
-	long long count;
-
-	count = static_cast<long long>(floor(static_cast<double>(hr - START_HR) / static_cast<double>(HOURS_PER_DAY)));
-	day += count;
-	hr -= count * HOURS_PER_DAY;
-
-	fixDay();
+bool smart_tm::isValid(const TimeContext& context /* =TimeContext::getDefault() */) const {
+	return yrInLimits(context) && monInLimits() && dayInLimits() && hrInLimits() && minInLimits() && secInLimits(context) && fracSecInLimits();
 }
 
-void smart_tm::fixMin() {
-	if (minInLimits()) return;
-
-	long long count;
-
-	count = static_cast<long long>(floor(static_cast<double>(min - START_MIN) / static_cast<double>(MINUTES_PER_HOUR)));
-	hr += count;
-	min -= count * MINUTES_PER_HOUR;
-
-	fixHr();
-}
-
-void smart_tm::fixSec() {
-	if (secInLimits()) return;
-
-	long long count;
-	long long addSec = sec;
-	sec = 0;
-	// compute by marching forward from *first* second of minute...
-	size_t oldEpoch = toEpoch();
-
-	// ...moving as many minutes as possible in one go (typical minutes, i.e. ignoring leap seconds)
-	// which is vastly faster than stepping a second or a minute at a time.
-	// it's constant time, in fact. It does, however, introduce leap second error...
-	count = static_cast<long long>(floor(static_cast<double>(addSec - START_SEC) / static_cast<double>(TYPICAL_SECONDS_PER_MINUTE)));
-	min += count;
-	addSec -= count * TYPICAL_SECONDS_PER_MINUTE;
-
-	fixMin();
-	sec = addSec;
-	size_t newEpoch = toEpoch();
-
-	// ...which is corrected here...
-	sec -= leapSecondsWalkedThroughFrom(oldEpoch, newEpoch);
-
-	fixMin();
-
-	// ...before finally bringing the corrected sec in range.
-	while (sec > START_SEC + numSecondsOfMinute() - 1) {
-		sec -= numSecondsOfMinute();
-		++min;
-		fixMin();
-	}
-
-	while (sec < START_SEC) {
-		--min;
-		fixMin();
-		sec += numSecondsOfMinute();
-	}
-}
-
-void smart_tm::fixFracSec() {
-	if (fracSecInLimits()) return;
-
-	long long count;
-
-	count = static_cast<long long>(floor(fracSec - START_FRAC_SEC));
-	sec += count;
-	fracSec -= static_cast<double>(count);
-
-	fixSec();
-}
-
-void smart_tm::adjust() {
-	if (isValid()) return;
-
-	// each of these calls propagates back up the chain after every change,
-	// ensuring accurate rollover of time changes to any field.
-	fixMon();
-	fixDay();
-	fixHr();
-	fixMin();
-	fixSec();
-	fixFracSec();
-}
-
-bool smart_tm::isValid() const {
-	return yrInLimits() && monInLimits() && dayInLimits() && hrInLimits() && minInLimits() && secInLimits() && fracSecInLimits();
-}
-
-long long leapSecondsWalkedThroughFrom(const size_t start, const size_t end) {
-	long long ret = 0;
+long long leapSecondsWalkedThroughFrom(const size_t start, const size_t end, const TimeContext& context /* =TimeContext::getDefault() */) {
+	// leap seconds are sorted, so the leap seconds in the
+	// closed interval between start and end are a contiguous run
+	TIME_STATS_COUNT(LeapLookups);
+	const std::vector<size_t>& deltas = context.leapSecondEpochs();
 	if (end > start) {
-		for (auto leapSecond : smart_tm::leapSecondDeltas) {
-			if (end >= leapSecond && start <= leapSecond) ++ret;
-		}
+		return std::upper_bound(deltas.begin(), deltas.end(), end) - std::lower_bound(deltas.begin(), deltas.end(), start);
 	}
 	else {
-		for (auto leapSecond : smart_tm::leapSecondDeltas) {
-			if (start >= leapSecond && end <= leapSecond) --ret;
-		}
+		return std::lower_bound(deltas.begin(), deltas.end(), end) - std::upper_bound(deltas.begin(), deltas.end(), start);
 	}
-
-	return ret;
 }
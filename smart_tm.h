@@ -66,9 +66,12 @@ std::cout << myTime << std::endl;
 #ifndef SMART_TM_H
 #define SMART_TM_H
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <cstdint>
@@ -80,6 +83,8 @@ std::cout << myTime << std::endl;
 #include <vector>
 
 #include "FileIO.h"
+#include "LeapTable.h"
+#include "TimeContext.h"
 
 #define BASE_10_PLEASE				(10)
 
@@ -107,6 +112,16 @@ std::cout << myTime << std::endl;
 // thanks to leap days
 #define TYPICAL_DAYS_PER_YEAR		(365)
 
+// day counts of the 400-year Gregorian cycle, used by
+// the constant-time civil <-> day number conversions
+#define DAYS_PER_400_YEARS			(146097)
+#define DAYS_PER_100_YEARS			(36524)
+#define DAYS_PER_4_YEARS			(1460)
+
+// days from 0000-03-01, the start of the first March-based
+// 400-year era, to 1900-01-01, day 0 of civil day numbering
+#define ERA_START_TO_DEFAULT_EPOCH	(693901)
+
 #define START_MON					(1)
 #define START_DAY					(1)
 #define START_HR					(0)
@@ -122,6 +137,86 @@ std::cout << myTime << std::endl;
 // variable end second; handled at runtime by func call
 #define END_FRAC_SEC				(1.0)
 
+// large enough for any format() output plus a terminating null,
+// even with every field at the limits of long long
+#define FORMAT_BUFFER_SIZE			(160)
+
+// floor(a / b), for b > 0, in integer arithmetic exact for any long long
+constexpr long long floorDiv(const long long a, const long long b) {
+	return (a % b < 0) ? a / b - 1 : a / b;
+}
+
+// Days since 1900-01-01 of a (valid) civil date, and the reverse.
+// Pure integer arithmetic, constant time, valid for negative day numbers too.
+constexpr long long daysFromCivil(const long long yr, const long long mon, const long long day) {
+	// count from 1 March so that the leap day, if any,
+	// is the very last day of the shifted year
+	const long long y = (mon <= 2) ? yr - 1 : yr;
+	const long long era = (y >= 0 ? y : y - 399) / 400;
+	const long long yrOfEra = y - era * 400;
+	const long long dayOfYr = (153 * (mon > 2 ? mon - 3 : mon + 9) + 2) / 5 + day - START_DAY;
+	const long long dayOfEra = yrOfEra * TYPICAL_DAYS_PER_YEAR + yrOfEra / 4 - yrOfEra / 100 + dayOfYr;
+	return era * DAYS_PER_400_YEARS + dayOfEra - ERA_START_TO_DEFAULT_EPOCH;
+}
+
+void civilFromDays(const long long days, long long& yr, long long& mon, long long& day);
+
+// The leap table built into the program (LeapTable.h) with a chosen
+// epoch year, exactly as TimeContext::create(epochYr) builds it, but as
+// a literal type. smart_tm's isValid(), isLeapMinute() and toEpoch()
+// overloads taking one are constexpr, so times known at compile time,
+// such as mission launches, are checked and converted at compile time.
+//
+// Example:
+/*
+
+constexpr EmbeddedContext embedded(1990);
+constexpr smart_tm launch(2001, 1, 1, 0, 0, 0, 0.0);
+static_assert(launch.isValid(embedded), "invalid launch time");
+constexpr size_t launchEpoch = launch.toEpoch(embedded);
+
+smart_tm::init(1990);
+const TimeConverter conv(launchEpoch, launch.fracSec);
+
+*/
+class EmbeddedContext {
+public:
+	explicit constexpr EmbeddedContext(const long long epochYr = DEFAULT_EPOCH_YEAR)
+		: epochYr(epochYr), epochNonleap(daysFromCivil(epochYr, START_MON, START_DAY) * SECONDS_PER_DAY) {}
+
+	constexpr long long epochYear() const { return epochYr; }
+
+	// Leap seconds walked through by a time nonleapSinceEpoch seconds
+	// (ignoring leap seconds) after epoch; inLeapSecond if that time
+	// is itself second '60', which has not yet walked through itself
+	constexpr size_t leapSecondsThrough(const long long nonleapSinceEpoch, const bool inLeapSecond) const {
+		const long long nonleap = nonleapSinceEpoch + epochNonleap;
+		size_t ret = 0;
+		for (size_t i = 0; i < EMBEDDED_LEAP_COUNT; ++i) {
+			const long long leapTime = static_cast<long long>(embeddedLeapTimes[i]);
+			if (leapTime > nonleap) break;
+			if (leapTime > epochNonleap && !(leapTime == nonleap && inLeapSecond)) ++ret;
+		}
+		return ret;
+	}
+
+	// Does the minute with this ordinal (see smart_tm::minuteOrdinal())
+	// end in a leap second?
+	constexpr bool isLeapMinute(const long long minuteOrdinal) const {
+		for (size_t i = 0; i < EMBEDDED_LEAP_COUNT; ++i) {
+			const long long leapTime = static_cast<long long>(embeddedLeapTimes[i]);
+			if (leapTime > epochNonleap && leapTime / TYPICAL_SECONDS_PER_MINUTE - 1 == minuteOrdinal) return true;
+		}
+		return false;
+	}
+
+private:
+	long long epochYr;
+
+	// seconds from 1900 to epoch, ignoring leap seconds, as in the leap table
+	long long epochNonleap;
+};
+
 class smart_tm {
 
 // Variables:
@@ -142,22 +237,23 @@ public:
 
 private:
 	
-	static bool initialized;
+	static constexpr short days[MONTHS_PER_YEAR] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 
-	static long long epochYr;
-	static smart_tm epoch;
+	// Days in the months before each month of a nonleap year, i.e. running sum of days[]
+	static constexpr short daysBeforeMon[MONTHS_PER_YEAR] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
 
-	static const short days[MONTHS_PER_YEAR];
 	static const size_t digits = std::numeric_limits<double>::digits10 + 2;
-	static std::vector<smart_tm> leapSecondTMs;
-	static std::vector<size_t> leapSecondDeltas;
 
 // Methods:
 
 public:
 
 	// Create smart_tm set to epoch
-	smart_tm() { *this = epoch; }
+	smart_tm() : smart_tm(TimeContext::getDefault()) {}
+
+	// Create smart_tm set to epoch of the given context
+	explicit smart_tm(const TimeContext& context)
+		: yr(context.epochYear()), mon(START_MON), day(START_DAY), hr(START_HR), min(START_MIN), sec(START_SEC), fracSec(START_FRAC_SEC) {}
 
 	// Create smart_tm from a tm struct
 	smart_tm(const tm& c_tm);
@@ -166,34 +262,73 @@ public:
 	smart_tm(const tm& c_tm, const double fracSec);
 
 	// Create smart_tm as seconds since current epoch
-	smart_tm(const size_t sinceEpoch);
+	smart_tm(const size_t sinceEpoch, const TimeContext& context = TimeContext::getDefault());
 
 	// Create smart_tm as seconds and fractional seconds since current epoch
-	smart_tm(const size_t sinceEpoch, const double fracSec);
+	smart_tm(const size_t sinceEpoch, const double fracSec, const TimeContext& context = TimeContext::getDefault());
+
+	// Create smart_tm as seconds and fractional seconds since current epoch,
+	// first trying leapHint, the leap table position found by the previous call,
+	// before searching the table. leapHint is updated for the next call,
+	// so runs of sorted or nearly-sorted times skip the search entirely.
+	// Start leapHint at 0.
+	smart_tm(const size_t sinceEpoch, const double fracSec, size_t& leapHint, const TimeContext& context = TimeContext::getDefault());
 
 	// Create smart_tm from raw entry of absolute year, month, day, etc.
-	smart_tm(const long long yr, const long long mon, const long long day, const long long hr, const long long min, const long long sec, const double fracSec)
+	constexpr smart_tm(const long long yr, const long long mon, const long long day, const long long hr, const long long min, const long long sec, const double fracSec)
 		: yr(yr), mon(mon), day(day), hr(hr), min(min), sec(sec), fracSec(fracSec) {}
 
-	~smart_tm() {}
+	~smart_tm() = default;
 
 	// Initialize epoch to first second of epochYear
 	// and import leap seconds from official IERS leap seconds file,
-	// typically named 'leap-seconds.list'
+	// typically named 'leap-seconds.list'.
+	// Replaces the default context (see TimeContext.h).
 	static void init(const long long epochYr, const std::string& leapFile);
 
+	// As above, but with the leap table built into the program
+	// (see LeapTable.h), so without any file I/O. Call the overload above
+	// instead to pick up a leap file newer than the build.
+	static void init(const long long epochYr);
+
 	// Warn user if leap seconds and epoch have not be initialised
 	static void checkInit();
 
+	// Year whose first second is epoch of the default context
+	static long long epochYear() { return TimeContext::getDefault().epochYear(); }
+
+	// Seconds since epoch of each leap second itself, sorted ascending,
+	// in the default context
+	static const std::vector<size_t>& leapSecondEpochs() { return TimeContext::getDefault().leapSecondEpochs(); }
+
 	friend std::ostream& operator<<(std::ostream& os, const smart_tm& time);
 	friend long long leapDaysWalkedThroughFrom(const smart_tm& start, const smart_tm& end);
-	friend long long leapSecondsWalkedThroughFrom(const size_t startEpoch, const size_t endEpoch);
+	friend class TimeContext;
 
 	// Is this a possible date and time?
-	bool isValid() const;
+	bool isValid(const TimeContext& context = TimeContext::getDefault()) const;
+
+	// Leap years occur on years evenly divisible by 4, except on
+	// years divisible by 100 but not by 400.
+	constexpr bool isLeapYear() const { return (yr % 4 == 0) && ((yr % 400 == 0) || (yr % 100 != 0)); }
+
+	bool isLeapMinute(const TimeContext& context = TimeContext::getDefault()) const;
 
-	bool isLeapYear() const;
-	bool isLeapMinute() const;
+	// isValid(), isLeapMinute() and toEpoch() against the built-in
+	// leap table, usable in constant expressions (see EmbeddedContext).
+	// Results match the calls above with TimeContext::create(epochYr).
+	constexpr bool isValid(const EmbeddedContext& context) const {
+		return yr >= context.epochYear() && yr <= END_YR && monInLimits() && dayInLimits() && hrInLimits() && minInLimits() &&
+			sec >= START_SEC && sec <= START_SEC + (isLeapMinute(context) ? TYPICAL_SECONDS_PER_MINUTE : TYPICAL_SECONDS_PER_MINUTE - 1) && fracSecInLimits();
+	}
+
+	constexpr bool isLeapMinute(const EmbeddedContext& context) const { return context.isLeapMinute(minuteOrdinal()); }
+
+	constexpr size_t toEpoch(const EmbeddedContext& context) const {
+		const long long nonleap = (daysFromCivil(yr, mon, day) - daysFromCivil(context.epochYear(), START_MON, START_DAY)) * SECONDS_PER_DAY +
+			(hr - START_HR) * SECONDS_PER_HOUR + (min - START_MIN) * TYPICAL_SECONDS_PER_MINUTE + (sec - START_SEC);
+		return static_cast<size_t>(nonleap) + context.leapSecondsThrough(nonleap, sec - START_SEC >= TYPICAL_SECONDS_PER_MINUTE);
+	}
 
 	// INCLUDING fractional seconds
 	bool equalsWithFrac(const smart_tm& other) const;
@@ -215,63 +350,118 @@ public:
 	// Any amount of time can be added or subtracted to 
 	// any field before an adjust() call, making that
 	// the preferred method of adjusting smart_tm.
-	void adjust();
+	//
+	// Constant time whatever the fields hold, as long as the result
+	// fits: each field carries into the next in one integer floor
+	// division, and the seconds are then counted from the start of
+	// the resulting minute with one leap table search.
+	void adjust(const TimeContext& context = TimeContext::getDefault());
 	
 	// Return seconds since epoch
-	size_t toEpoch() const;
+	size_t toEpoch(const TimeContext& context = TimeContext::getDefault()) const;
 
 	// Return seconds since epoch, including fractional seconds
-	size_t toEpoch(double& fracSec) const;
+	size_t toEpoch(double& fracSec, const TimeContext& context = TimeContext::getDefault()) const;
+
+	// Return seconds since epoch, including fractional seconds,
+	// reusing and updating leapHint as in the leapHint constructor
+	size_t toEpoch(double& fracSec, size_t& leapHint, const TimeContext& context = TimeContext::getDefault()) const;
 
 	// generate string outputs
 	std::string toString(const char dateSeparator='/') const;
 	std::string dateToString(const char dateSeparator='/') const;
 	std::string timeToString() const;
 
+	// Write the same text as toString() into buf without allocating,
+	// followed by a terminating null if there is room for one.
+	// Returns the number of characters written, not counting the null,
+	// or 0 (writing nothing) if they do not fit in cap.
+	// A cap of FORMAT_BUFFER_SIZE always fits.
+	size_t format(char* buf, const size_t cap, const char dateSeparator='/') const;
+
+	// Day of the year, starting at 1 on Jan 1
+	long long dayOfYear() const;
+
+	// Read a time from text, in any of the forms
+	//	YYYY/MM/DD hh:mm:ss.fff		(toString(), with any of '/', '-' or ':' between date fields)
+	//	YYYY-MM-DDThh:mm:ss.fffZ	(ISO 8601)
+	//	YYYY-DDDThh:mm:ss.fffZ		(day of year; also YYYY:DDD:hh:mm:ss etc.)
+	// The date and time are separated by 'T', ' ' or the date separator,
+	// the fractional seconds (any number of digits, after '.' or ',')
+	// and the trailing 'Z' are optional, and the result must be a valid time,
+	// so e.g. second 60 is only accepted if isLeapMinute() allows it.
+	//
+	// In the style of std::from_chars: parses from the start of [first, last)
+	// and returns one past the last character used, or nullptr
+	// (leaving 'time' untouched) if there is no valid time there.
+	static const char* parse(const char* first, const char* last, smart_tm& time, const TimeContext& context = TimeContext::getDefault());
+
+	// As above, but the whole string must be a time
+	static bool parse(const std::string& text, smart_tm& time, const TimeContext& context = TimeContext::getDefault());
+
+	// Parse n times, one every 'stride' bytes from text, e.g. a fixed-width
+	// column of a log or CSV file. Each must start at its record and be in
+	// one of the forms above; anything after it in the record is ignored.
+	// Fixed-width 'YYYY?MM?DD?hh:mm' prefixes are read with SIMD where available.
+	// Returns the number parsed before the first failure.
+	static size_t parseFixedWidth(const char* text, const size_t stride, const size_t n, smart_tm* timesOut, const TimeContext& context = TimeContext::getDefault());
+
 private:
 
 	// Corrected for leap day if needed
-	short numDaysOfMonth() const;
+	constexpr short numDaysOfMonth() const {
+		// constant and dependent only on month...
+		// ...except leap years, where Feb has 29 instead of 28 days.
+		return ((mon - 1 == Month::Feb) && isLeapYear()) ? days[Month::Feb] + 1 : days[mon - 1];
+	}
 
-	// Inclusive
-	size_t leapDaysWalkedThroughSinceEpoch() const;
+	// Write dateToString() / timeToString() text at out, which must have
+	// room for it. Return one past the last character written.
+	char* formatDate(char* out, const char dateSeparator) const;
+	char* formatTime(char* out) const;
 
 	// Inclusive
-	size_t leapSecondsWalkedThroughSinceEpoch() const;
+	size_t leapDaysWalkedThroughSinceEpoch(const TimeContext& context) const;
+
+	// Leap days (Feb 29ths) from year 0 up to, but not including, the given date.
+	// If the year is a leap year but the date is not after leap day,
+	// the year itself is not counted.
+	static constexpr long long leapDaysBefore(const long long yr, const long long mon, const long long day) {
+		return leapDaysThroughYear(((yr % 4 == 0) && ((yr % 400 == 0) || (yr % 100 != 0)) && ((mon - 1 == Month::Feb && day <= 29) || mon - 1 == Month::Jan)) ? yr - 1 : yr);
+	}
+
+	static constexpr long long leapDaysThroughYear(const long long yr) { return yr / 4 + yr / 400 - yr / 100; }
+
+	// Seconds since epoch as if there were no leap seconds,
+	// i.e. toEpoch() before its leap second correction
+	size_t nonleapSinceEpoch(const TimeContext& context) const;
+
+	// Inclusive. Takes this time's nonleap seconds since epoch,
+	// which toEpoch() has already computed, and a leap table position hint.
+	size_t leapSecondsWalkedThroughSinceEpoch(const long long nonleapSinceEpoch, size_t& leapHint, const TimeContext& context) const;
 
 	// Corrected for leap second if needed
-	short numSecondsOfMinute() const;
-
-	// These calls all expect the larger units of time above them
-	// to be valid. For example, fixDay() expects a valid year and month,
-	// while fixMin() expects a valid year, month, day, and hour.
-	void fixMon();
-	void fixDay();
-	void fixHr();
-	void fixMin();
-	void fixSec();
-	void fixFracSec();
-
-	// restore days to acceptable range by
-	// stepping month back or forward as necessary
-	void stepMon();
-
-	// restore days to acceptable range by
-	// stepping month back or forward as necessary,
-	// ignoring leap correction
-	//
-	// Used in fixDay() for coarse adjustment by year,
-	// correction for which is already applied by
-	// leapDaysWalkedThroughFrom().
-	void stepMonNoLeapCorrection();
-
-	inline bool yrInLimits() const { return yr >= epoch.yr && yr <= END_YR; }
-	inline bool monInLimits() const { return mon >= START_MON && mon <= END_MON; }
-	inline bool dayInLimits() const { return day >= START_DAY && day <= START_DAY + numDaysOfMonth() - 1; };
-	inline bool hrInLimits() const { return hr >= START_HR && hr <= END_HR; }
-	inline bool minInLimits() const { return min >= START_MIN && min <= END_MIN; }
-	inline bool secInLimits() const { return sec >= START_SEC && sec <= START_SEC + numSecondsOfMinute() - 1.0; }
-	inline bool fracSecInLimits() const { return fracSec >= START_FRAC_SEC && fracSec < END_FRAC_SEC; }
+	short numSecondsOfMinute(const TimeContext& context) const;
+
+	// Minutes since 1900-01-01 00:00 of the minute this time falls in,
+	// counting every minute as one regardless of leap seconds
+	constexpr long long minuteOrdinal() const { return daysFromCivil(yr, mon, day) * HOURS_PER_DAY * MINUTES_PER_HOUR + (hr - START_HR) * MINUTES_PER_HOUR + (min - START_MIN); }
+
+	// Set all fields from a leap-aware count of seconds since epoch
+	// in constant time, without going through adjust().
+	void setFromEpoch(const long long sinceEpoch, size_t& leapHint, const TimeContext& context);
+
+	// Carry whole seconds out of fracSec the same way adjust() does,
+	// without normalizing anything else. Returns the seconds carried.
+	long long carryFracSec();
+
+	inline bool yrInLimits(const TimeContext& context) const { return yr >= context.epochYear() && yr <= END_YR; }
+	constexpr bool monInLimits() const { return mon >= START_MON && mon <= END_MON; }
+	constexpr bool dayInLimits() const { return day >= START_DAY && day <= START_DAY + numDaysOfMonth() - 1; };
+	constexpr bool hrInLimits() const { return hr >= START_HR && hr <= END_HR; }
+	constexpr bool minInLimits() const { return min >= START_MIN && min <= END_MIN; }
+	inline bool secInLimits(const TimeContext& context) const { return sec >= START_SEC && sec <= START_SEC + numSecondsOfMinute(context) - 1.0; }
+	constexpr bool fracSecInLimits() const { return fracSec >= START_FRAC_SEC && fracSec < END_FRAC_SEC; }
 };
 
 inline bool operator< (const smart_tm& lhs, const smart_tm& rhs) {
@@ -301,11 +491,16 @@ inline double operator-(const smart_tm& lhs, const smart_tm& rhs) {
 }
 
 long long leapDaysWalkedThroughFrom(const smart_tm& start, const smart_tm& end);
-long long leapSecondsWalkedThroughFrom(const size_t start, const size_t end);
+long long leapSecondsWalkedThroughFrom(const size_t start, const size_t end, const TimeContext& context = TimeContext::getDefault());
 
 // specifically for epoch checks, i.e. Jan 1 00:00:00 of both years
 long long leapDaysWalkedThroughFrom(const size_t startYr, const size_t endYr);
 
+// Write value in decimal, zero-padded on the left to at least width characters,
+// exactly as an iostream with setfill('0') and setw(width) would.
+// Returns one past the last character written.
+char* writePadded(char* out, const long long value, const int width);
+
 // Specifically the number of seconds from one epoch (Jan 1 00:00:00) to another
 // for converting the leap second file's epochs (referenced to year 1900) to
 // a user-specified year